@@ -0,0 +1,53 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+using namespace std;
+
+#include "../Models/Position.h"
+#include "Score.h"
+
+// Режим оценки позиции
+enum class Scoring
+{
+    NUMBER_ONLY,         // Только количество фигур
+    NUMBER_AND_POTENTIAL // Количество фигур и продвижение шашек
+};
+
+// Режим оценки по его названию в настройках (например, "NumberAndPotential")
+inline Scoring parse_scoring(const string& scoring_mode)
+{
+    return scoring_mode == "NumberAndPotential" ? Scoring::NUMBER_AND_POTENTIAL : Scoring::NUMBER_ONLY;
+}
+
+// Класс Evaluator оценивает позицию в листьях дерева поиска.
+// Все слагаемые оценки берутся из счётчиков Position::material, которые обновляются в make/unmake.
+// Режим оценки - параметр шаблона, поэтому все проверки режима выполняются при компиляции.
+// Новый режим добавляется значением Scoring, веткой в force, в parse_scoring и в выборе bind<S, PRUNE>
+// в конструкторе Searcher (иначе поиск молча возьмёт режим по умолчанию).
+template <Scoring S>
+class Evaluator
+{
+public:
+    // Функция calc_score оценивает позицию для стороны color: EVAL_SCALE * (свои - чужие) / (свои + чужие),
+    // где "свои" и "чужие" - ценность фигур сторон. Оценка растёт вместе с отношением сил сторон,
+    // поэтому при перевесе размен выгоден: отношение от него растёт.
+    // Позиции без фигур у одной из сторон оценивает поиск (это конец партии).
+    static Score calc_score(const Position& pos, const bool color)
+    {
+        const int own = force(pos.material, color), opp = force(pos.material, !color);
+        return Score(int64_t(EVAL_SCALE) * (own - opp) / (own + opp));
+    }
+
+private:
+    // Ценность фигур стороны color в двадцатых долях шашки.
+    static int force(const Material& m, const bool color)
+    {
+        // Коэффициент ценности дамки: по умолчанию 4, а при режиме "NumberAndPotential" – 5.
+        constexpr int q_coef = (S == Scoring::NUMBER_AND_POTENTIAL) ? 5 : 4;
+        int res = 20 * (m.men[color] + q_coef * m.kings[color]);
+        // Если выбран режим "NumberAndPotential", добавляем бонусы за продвижение шашек (1/20 шашки за строку).
+        if constexpr (S == Scoring::NUMBER_AND_POTENTIAL)
+            res += m.advance[color];
+        return res;
+    }
+};
@@ -0,0 +1,181 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+using namespace std;
+
+#include "../Models/Position.h"
+#include "Score.h"
+
+// Тип границы, которую даёт сохранённая оценка
+enum class Bound : uint8_t
+{
+    NONE,  // Пустая запись
+    EXACT, // Точная оценка
+    LOWER, // Истинная оценка не меньше сохранённой
+    UPPER  // Истинная оценка не больше сохранённой
+};
+
+// Запись таблицы транспозиций
+struct Hash_entry
+{
+    uint64_t key = 0;          // Полный ключ позиции (для проверки совпадения)
+    Score score = 0;           // Оценка позиции (выигрыш и проигрыш - от самой позиции, см. score_to_table)
+    sq_move best;              // Лучший найденный ход (или пустой ход)
+    int8_t draft = -1;         // Оставшаяся глубина, на которой получена оценка
+    Bound bound = Bound::NONE; // Тип оценки
+    uint8_t age = 0;           // Номер поиска, в котором запись была сохранена
+};
+
+// Класс Hash_table - таблица транспозиций фиксированного размера.
+// Каждая корзина содержит две записи: первая заменяется только более глубокой оценкой
+// (или записью из прошлого поиска), вторая заменяется всегда.
+//
+// Таблица общая для всех потоков поиска и работает без блокировок: запись хранится в трёх
+// атомарных словах, а вместо ключа сохраняется ключ XOR оба слова данных. Если запись была
+// прочитана во время одновременной записи из другого потока, проверка ключа не сойдётся
+// и запись будет просто считаться отсутствующей.
+class Hash_table
+{
+public:
+    Hash_table() = default;
+
+    // Размер таблицы задаётся в мегабайтах (0 отключает таблицу)
+    explicit Hash_table(const size_t size_mb)
+    {
+        resize(size_mb);
+    }
+
+    void resize(const size_t size_mb)
+    {
+        // Количество корзин округляется вниз до степени двойки, чтобы индекс брался маской
+        const size_t buckets = size_mb * 1024 * 1024 / sizeof(Bucket);
+        size_t pow2 = 1;
+        while (pow2 * 2 <= buckets)
+            pow2 *= 2;
+        size = (buckets ? pow2 : 0);
+        table.reset(size ? new Bucket[size] : nullptr);
+        mask = (size ? size - 1 : 0);
+        clear();
+    }
+
+    // Очищает все записи
+    void clear()
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            for (Slot& slot : table[i].slots)
+            {
+                slot.check.store(0, memory_order_relaxed);
+                slot.score.store(0, memory_order_relaxed);
+                slot.data.store(0, memory_order_relaxed);
+            }
+        }
+        age = 0;
+    }
+
+    // Начало нового поиска: старые записи становятся кандидатами на замену
+    void new_search()
+    {
+        ++age;
+    }
+
+    bool enabled() const
+    {
+        return size != 0;
+    }
+
+    // Поиск записи по ключу, возвращает false, если записи нет
+    bool probe(const uint64_t key, Hash_entry& entry) const
+    {
+        if (!size)
+            return false;
+        const Bucket& bucket = table[key & mask];
+        for (const Slot& slot : bucket.slots)
+        {
+            if (read(slot, entry) && entry.key == key)
+                return true;
+        }
+        return false;
+    }
+
+    // Сохранение оценки позиции
+    void store(const uint64_t key, const Score score, const int draft, const Bound bound, const sq_move best)
+    {
+        if (!size)
+            return;
+        Bucket& bucket = table[key & mask];
+        Hash_entry deep, fresh;
+        read(bucket.slots[0], deep);
+        read(bucket.slots[1], fresh);
+        Slot* target = &bucket.slots[1];
+        Hash_entry* prev = &fresh;
+        if (deep.key == key || deep.bound == Bound::NONE || deep.age != age || draft >= deep.draft)
+        {
+            target = &bucket.slots[0];
+            prev = &deep;
+        }
+        else if (fresh.key == key && fresh.draft > draft)
+            return;
+        Hash_entry entry;
+        entry.key = key;
+        entry.score = score;
+        // Если для позиции новый лучший ход не найден, сохраняем прежний
+        entry.best = (best.from != -1 ? best : (prev->key == key ? prev->best : sq_move()));
+        entry.draft = int8_t(draft);
+        entry.bound = bound;
+        entry.age = age;
+        write(*target, entry);
+    }
+
+private:
+    struct Slot
+    {
+        atomic<uint64_t> check{ 0 }; // key ^ score ^ data
+        atomic<uint64_t> score{ 0 }; // Биты оценки (Score)
+        atomic<uint64_t> data{ 0 };  // Упакованные ход, глубина, тип оценки и возраст
+    };
+
+    struct Bucket
+    {
+        Slot slots[2];
+    };
+
+    // Упаковка: from + 1, to + 1, cap + 1 по 6 бит, draft - 8 бит, bound - 8 бит, age - 8 бит
+    static uint64_t pack(const Hash_entry& entry)
+    {
+        return uint64_t(uint8_t(entry.best.from + 1)) | uint64_t(uint8_t(entry.best.to + 1)) << 6 |
+               uint64_t(uint8_t(entry.best.cap + 1)) << 12 | uint64_t(uint8_t(entry.draft)) << 18 |
+               uint64_t(entry.bound) << 26 | uint64_t(entry.age) << 34;
+    }
+
+    static bool read(const Slot& slot, Hash_entry& entry)
+    {
+        const uint64_t check = slot.check.load(memory_order_relaxed);
+        const uint64_t score = slot.score.load(memory_order_relaxed);
+        const uint64_t data = slot.data.load(memory_order_relaxed);
+        entry.bound = Bound((data >> 26) & 0xFF);
+        if (entry.bound == Bound::NONE)
+            return false;
+        entry.key = check ^ score ^ data;
+        entry.score = Score(uint32_t(score));
+        entry.best = sq_move(int(data & 63) - 1, int((data >> 6) & 63) - 1, int((data >> 12) & 63) - 1);
+        entry.draft = int8_t((data >> 18) & 0xFF);
+        entry.age = uint8_t((data >> 34) & 0xFF);
+        return true;
+    }
+
+    static void write(Slot& slot, const Hash_entry& entry)
+    {
+        const uint64_t score = uint32_t(entry.score);
+        const uint64_t data = pack(entry);
+        slot.check.store(entry.key ^ score ^ data, memory_order_relaxed);
+        slot.score.store(score, memory_order_relaxed);
+        slot.data.store(data, memory_order_relaxed);
+    }
+
+    unique_ptr<Bucket[]> table;
+    size_t size = 0;
+    size_t mask = 0;
+    uint8_t age = 0;
+};
@@ -0,0 +1,442 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "../Models/Move.h"
+#include "../Models/Position.h"
+#include "Hash_table.h"
+#include "Move_gen.h"
+#include "Opening_book.h"
+#include "Searcher.h"
+#include "Tablebase.h"
+
+// Начальная полуширина окна поиска вокруг оценки предыдущей итерации: 2.5% шкалы оценки.
+// Оценка - доля перевеса в общем материале (см. Evaluator), поэтому в шашках окно сужается с разменами:
+// около 0.6 шашки в начальной позиции и 1/20 шашки, когда у сторон осталось по одной шашке.
+const Score ASPIRATION_WIDTH = EVAL_SCALE / 40;
+
+// Настройки движка. Движок не зависит от доски, окна и файла настроек:
+// их заполняет вызывающий код (в игре - по settings.json).
+struct Engine_settings
+{
+    unsigned seed = 0;                          // Seed перемешивания ходов
+    string scoring_mode = "NumberAndPotential"; // Режим оценки позиций
+    string optimization = "O1";                 // Уровень оптимизации
+    size_t hash_mb = 16;                        // Размер таблицы транспозиций в мегабайтах
+    int move_time_ms = 0;                       // Ограничение времени на ход (0 - фиксированная глубина)
+    int threads = 1;                            // Количество потоков поиска
+    string parallel_mode = "YBW";               // Способ распараллеливания: "YBW" или "LazySMP"
+    bool quiescence = true;                     // Досчитывать удары за горизонтом поиска
+    string tablebase_path;                      // Файл эндшпильной базы (пустая строка - без базы)
+    string book_path;                           // Файл дебютной книги (пустая строка - без книги)
+};
+
+// Класс Logic - интерфейс движка: поиск ходов и лучшего хода в позиции, заданной матрицей доски.
+class Logic
+{
+public:
+    explicit Logic(const Engine_settings& settings)
+        : scoring_mode(settings.scoring_mode), optimization(settings.optimization), book_rand_eng(settings.seed)
+    {
+        // Выделяем таблицу транспозиций заданного размера (в мегабайтах).
+        hash_table.resize(settings.hash_mb);
+
+        // Ограничение времени на ход (0 - поиск на фиксированную глубину Max_depth).
+        move_time_ms = settings.move_time_ms;
+
+        // Каждый поток поиска получает свой объект Searcher; у вспомогательных потоков свой seed,
+        // чтобы они перебирали равноценные ходы в другом порядке.
+        const int threads = max(1, settings.threads);
+        // Способ распараллеливания: "YBW" - потоки делят ходы узлов дерева, "LazySMP" - ищут независимо.
+        split_mode = (settings.parallel_mode != "LazySMP");
+        if (split_mode && threads > 1)
+            split_pool = make_unique<Split_pool>(threads - 1);
+        for (int i = 0; i < threads; ++i)
+            searchers.emplace_back(scoring_mode, optimization, settings.seed + unsigned(i), settings.quiescence);
+
+        // Эндшпильная база: если файл не найден, бот играет без неё.
+        if (!settings.tablebase_path.empty() && tablebase->load(settings.tablebase_path))
+        {
+            for (Searcher& searcher : searchers)
+                searcher.set_tablebase(tablebase.get());
+        }
+        // Дебютная книга: если файл не найден, бот ищет ход с начала партии.
+        if (!settings.book_path.empty())
+            book->load(settings.book_path);
+    }
+
+    // Функция, возвращающая лучшую последовательность ходов (цепочку ударов, если это необходимо)
+    // для фигур заданного цвета.
+    vector<move_pos> find_best_turns(const vector<vector<POS_T>>& mtx, const bool color)
+    {
+        // Если на время соперника шёл фоновый поиск, то при совпадении позиции берём его результат,
+        // а иначе останавливаем его (заполненная им таблица транспозиций всё равно пригодится).
+        if (ponder_thread.joinable())
+        {
+            const bool hit = (ponder_mtx == mtx && ponder_color == color);
+            vector<move_pos> res = (hit ? finish_ponder() : vector<move_pos>());
+            stop_ponder();
+            if (!res.empty())
+                return res;
+        }
+
+        // Матрица доски переводится в битовое представление один раз, дальше поиск ходит по этой позиции
+        // вниз и обратно вверх, выполняя и отменяя ходы на месте.
+        Position pos = Position::from_mtx(mtx);
+
+        // Позиция есть в дебютной книге или в эндшпильной базе: ход берётся оттуда без поиска.
+        vector<sq_move> chain;
+        if ((book->loaded() && book->find_turn(pos, color, book_rand_eng, chain)) ||
+            (tablebase->loaded() && tablebase->best_turn(pos, color, chain)))
+        {
+            vector<move_pos> res;
+            for (const sq_move turn : chain)
+                res.push_back(turn.to_move_pos());
+            return res;
+        }
+        return think(pos, color, Max_depth, false, search_cancel);
+    }
+
+    // Запуск поиска на время соперника. mtx - позиция после хода бота, color - цвет соперника.
+    // Ответ соперника предсказывается по таблице транспозиций (лучший ход в его узле из только что
+    // законченного поиска), и в фоновом потоке ищется ход бота в позиции после этого ответа.
+    // Возвращает false, если ответ предсказать не удалось (например, ход был взят из книги).
+    bool start_ponder(const vector<vector<POS_T>>& mtx, const bool color)
+    {
+        stop_ponder();
+        Position pos = Position::from_mtx(mtx);
+        if (!predict_reply(pos, color))
+            return false;
+        ponder_mtx = pos.to_mtx();
+        ponder_color = !color;
+        ponder_result.clear();
+        ponder_done = false;
+        ponder_start = chrono::steady_clock::now();
+        // Глубина запоминается сейчас: пока думает соперник, Max_depth меняет вызывающий код.
+        const int depth = Max_depth;
+        ponder_thread = thread([this, pos, depth]() mutable {
+            ponder_result = think(pos, ponder_color, depth, true, ponder_cancel);
+            ponder_done = true;
+        });
+        return true;
+    }
+
+    // Остановка поиска на время соперника (его результат отбрасывается).
+    void stop_ponder()
+    {
+        if (!ponder_thread.joinable())
+            return;
+        ponder_cancel = true;
+        ponder_thread.join();
+        ponder_cancel = false;
+    }
+
+    // Запуск find_best_turns в фоновом потоке, чтобы вызывающий поток (окно игры) не блокировался.
+    // on_done вызывается из потока поиска, когда результат готов (например, чтобы разбудить ожидание событий).
+    // До take_search_result или cancel_search другие функции объекта вызывать нельзя.
+    void start_search(const vector<vector<POS_T>>& mtx, const bool color, function<void()> on_done = nullptr)
+    {
+        cancel_search();
+        search_result.clear();
+        search_done = false;
+        search_thread = thread([this, mtx, color, on_done]() {
+            search_result = find_best_turns(mtx, color);
+            search_done = true;
+            if (on_done)
+                on_done();
+        });
+    }
+
+    // Закончен ли фоновый поиск
+    bool search_finished() const
+    {
+        return search_done;
+    }
+
+    // Результат фонового поиска (если поиск ещё идёт, дожидается его окончания).
+    vector<move_pos> take_search_result()
+    {
+        if (search_thread.joinable())
+            search_thread.join();
+        return move(search_result);
+    }
+
+    // Прерывание фонового поиска, результат отбрасывается.
+    void cancel_search()
+    {
+        if (!search_thread.joinable())
+            return;
+        search_cancel = true;
+        search_thread.join();
+        search_cancel = false;
+        search_result.clear();
+    }
+
+    ~Logic()
+    {
+        cancel_search();
+        stop_ponder();
+    }
+
+    // Потоки фонового поиска хранят указатель на объект, поэтому объект не копируется и не перемещается.
+    Logic(const Logic&) = delete;
+    Logic& operator=(const Logic&) = delete;
+
+private:
+    // Поиск лучшего хода стороны color. При ограничении времени - итеративное углубление,
+    // иначе - один поиск на глубину depth. infinite - поиск на время соперника: ограничения времени нет,
+    // углубление продолжается до остановки, результатом служит последняя законченная итерация.
+    // cancel - флаг отмены этого поиска (search_cancel или ponder_cancel): поиск его не сбрасывает,
+    // поэтому отмена не теряется, даже если выставлена до начала поиска.
+    vector<move_pos> think(Position pos, const bool color, const int depth, const bool infinite,
+                           const atomic<bool>& cancel)
+    {
+        hash_table.new_search();
+        stop = false;
+        cancel_flag = &cancel;
+        // В режиме YBW все потоки работают в одном дереве и останавливаются общим флагом.
+        for (size_t i = 0; i < searchers.size(); ++i)
+            searchers[i].new_search(&hash_table, (i == 0 || split_mode ? &stop : &helpers_stop),
+                                    (split_mode ? split_pool.get() : nullptr), &cancel);
+
+        // Без ограничения времени выполняем один поиск на глубину depth.
+        if (move_time_ms <= 0)
+        {
+            search_depth(pos, color, depth);
+            return (aborted() ? vector<move_pos>() : searchers[0].collect_best_turns());
+        }
+
+        // Итеративное углубление: ищем на глубину 0, 1, 2, ..., пока не истечёт время.
+        // Лучшая цепочка предыдущей итерации перебирается первой, а результат прерванной итерации отбрасывается.
+        const auto deadline = chrono::steady_clock::now() + chrono::milliseconds(move_time_ms);
+        for (Searcher& searcher : searchers)
+            searcher.deadline = deadline;
+        vector<move_pos> res;
+        Score prev_score = 0;
+        for (int d = 0; d <= MAX_SEARCH_DEPTH; ++d)
+        {
+            // Первая итерация всегда выполняется полностью, чтобы у бота был ход.
+            for (Searcher& searcher : searchers)
+                searcher.time_limited = (d > 0 && !infinite);
+            const Score score = (d > 0 ? aspiration_search(pos, color, d, prev_score) : search_depth(pos, color, d));
+            if (aborted())
+                break;
+            prev_score = score;
+            res = searchers[0].collect_best_turns();
+            // Если найден форсированный выигрыш или проигрыш, углубляться дальше незачем.
+            if (is_decisive(score) || (!infinite && chrono::steady_clock::now() >= deadline))
+                break;
+        }
+        for (Searcher& searcher : searchers)
+            searcher.time_limited = false;
+        return res;
+    }
+
+    // Ход соперника из таблицы транспозиций (вместе с цепочкой ударов) выполняется на позиции pos.
+    bool predict_reply(Position& pos, const bool color) const
+    {
+        int sq = -1;
+        while (true)
+        {
+            Move_list list;
+            if (sq != -1)
+                Move_gen::find_turns(pos, sq, list);
+            else
+                Move_gen::find_turns(pos, color, list);
+            // Цепочка ударов закончилась
+            if (sq != -1 && !list.have_beats)
+                return true;
+            Hash_entry entry;
+            if (!hash_table.probe(Searcher::node_key(pos, color, sq), entry) ||
+                find(list.begin(), list.end(), entry.best) == list.end())
+                return false;
+            Undo_info undo;
+            pos.make(entry.best, undo);
+            if (!list.have_beats)
+                return true;
+            sq = entry.best.to;
+        }
+    }
+
+    // Ответ соперника совпал с предсказанным. При поиске на фиксированную глубину дожидаемся его
+    // окончания, а при ограничении времени даём ему столько времени, сколько длится обычный ход
+    // (считая с начала поиска на время соперника), и берём последнюю законченную итерацию.
+    // Если фоновый поиск хода отменён, поиск на время соперника останавливается сразу.
+    vector<move_pos> finish_ponder()
+    {
+        const auto deadline = ponder_start + chrono::milliseconds(move_time_ms);
+        while (!ponder_done && !search_cancel && (move_time_ms <= 0 || chrono::steady_clock::now() < deadline))
+            this_thread::sleep_for(chrono::milliseconds(1));
+        ponder_cancel = true;
+        ponder_thread.join();
+        ponder_cancel = false;
+        return ponder_result;
+    }
+
+    // Остановлен ли текущий поиск: по истечении времени или отменой
+    bool aborted() const
+    {
+        return stop || *cancel_flag;
+    }
+
+    // Поиск в окне вокруг оценки предыдущей итерации углубления (aspiration window). Узкое окно даёт
+    // больше отсечений; если оценка вышла за окно, окно с этой стороны расширяется и поиск повторяется.
+    // Окно шире всей шкалы оценки по соотношению сил заменяется полным.
+    Score aspiration_search(Position& pos, const bool color, const int depth, const Score prev_score)
+    {
+        // При выигрыше или проигрыше окно не используется.
+        if (is_decisive(prev_score))
+            return search_depth(pos, color, depth);
+        Score low_width = ASPIRATION_WIDTH, high_width = ASPIRATION_WIDTH;
+        while (true)
+        {
+            const Score alpha = (low_width <= EVAL_SCALE ? prev_score - low_width : -SCORE_INF);
+            const Score beta = (high_width <= EVAL_SCALE ? prev_score + high_width : SCORE_INF);
+            const Score score = search_depth(pos, color, depth, alpha, beta);
+            if (aborted() || (score > alpha && score < beta))
+                return score;
+            if (score <= alpha)
+                low_width *= 4;
+            else
+                high_width *= 4;
+        }
+    }
+
+    // Поиск на заданную глубину. Главный поток (searchers[0]) определяет результат, а вспомогательные
+    // потоки параллельно ищут ту же позицию (через одну - на единицу глубже) и заполняют общую
+    // таблицу транспозиций, из которой главный поток берёт готовые оценки и лучшие ходы.
+    // Вспомогательные потоки останавливаются, как только главный поток закончил.
+    Score search_depth(Position& pos, const bool color, const int depth, const Score alpha = -SCORE_INF,
+                       const Score beta = SCORE_INF)
+    {
+        if (split_mode)
+            return split_search(pos, color, depth, alpha, beta);
+        helpers_stop = false;
+        vector<thread> helpers;
+        for (size_t i = 1; i < searchers.size(); ++i)
+        {
+            helpers.emplace_back([this, pos, color, depth, alpha, beta, i]() mutable {
+                searchers[i].search(pos, color, depth + int(i % 2), alpha, beta);
+            });
+        }
+        const Score score = searchers[0].search(pos, color, depth, alpha, beta);
+        helpers_stop = true;
+        for (thread& helper : helpers)
+            helper.join();
+        return score;
+    }
+
+    // Поиск на заданную глубину с точками разделения (Young Brothers Wait): главный поток ищет как обычно,
+    // а после того как в узле просчитан первый ход, оставшиеся ходы разбирают свободные потоки.
+    Score split_search(Position& pos, const bool color, const int depth, const Score alpha, const Score beta)
+    {
+        if (!split_pool)
+            return searchers[0].search(pos, color, depth, alpha, beta);
+        split_pool->start();
+        vector<thread> workers;
+        for (size_t i = 1; i < searchers.size(); ++i)
+        {
+            workers.emplace_back([this, i]() {
+                const int worker = int(i) - 1;
+                while (Split_point* sp = split_pool->wait_work(worker))
+                {
+                    searchers[i].help(*sp);
+                    sp->leave();
+                    split_pool->finish_work(worker);
+                }
+            });
+        }
+        const Score score = searchers[0].search(pos, color, depth, alpha, beta);
+        split_pool->shutdown();
+        for (thread& worker : workers)
+            worker.join();
+        return score;
+    }
+
+public:
+    // Функции для поиска возможных ходов.
+    // find_turns(mtx, color) ищет ходы для всех фигур заданного цвета.
+    void find_turns(const vector<vector<POS_T>>& mtx, const bool color)
+    {
+        Move_list list;
+        Move_gen::find_turns(Position::from_mtx(mtx), color, list);
+        set_turns(list);
+    }
+
+    // find_turns(mtx, x, y) ищет ходы для фигуры, находящейся в клетке (x, y).
+    void find_turns(const vector<vector<POS_T>>& mtx, const POS_T x, const POS_T y)
+    {
+        Move_list list;
+        Move_gen::find_turns(Position::from_mtx(mtx), sq_index(x, y), list);
+        set_turns(list);
+    }
+
+private:
+    // Переносит найденные ходы в публичный вектор turns (используется только вне поиска).
+    void set_turns(const Move_list& list)
+    {
+        turns.clear();
+        for (const sq_move turn : list)
+            turns.push_back(turn.to_move_pos());
+        have_beats = list.have_beats;
+    }
+
+public:
+    // Вектор для хранения найденных ходов.
+    vector<move_pos> turns;
+    // Флаг наличия ударов (capture moves) среди найденных ходов.
+    bool have_beats = false;
+    // Максимальная глубина рекурсии для алгоритма минимакс.
+    int Max_depth = 0;
+
+private:
+    // Режим оценки ходов (например, "NumberAndPotential").
+    string scoring_mode;
+    // Уровень оптимизации (например, "O0" или иное).
+    string optimization;
+    // Таблица транспозиций, общая для всех потоков поиска.
+    Hash_table hash_table;
+    // Объекты поиска для каждого потока (нулевой - главный поток).
+    vector<Searcher> searchers;
+    // Флаг остановки главного поиска по истечении времени.
+    atomic<bool> stop{ false };
+    // Флаги отмены поиска хода (find_best_turns, start_search) и поиска на время соперника.
+    // Выставляются только вызывающим кодом и сбрасываются после остановки потока.
+    atomic<bool> search_cancel{ false };
+    atomic<bool> ponder_cancel{ false };
+    // Флаг отмены текущего поиска (один из двух выше).
+    const atomic<bool>* cancel_flag = nullptr;
+    // Распределять ли ходы узлов между потоками (режим YBW) вместо независимого поиска (LazySMP).
+    bool split_mode = true;
+    // Пул вспомогательных потоков режима YBW (только если потоков больше одного).
+    unique_ptr<Split_pool> split_pool;
+    // Флаг остановки вспомогательных потоков.
+    atomic<bool> helpers_stop{ false };
+    // Ограничение времени на ход в миллисекундах (0 - без ограничения).
+    int move_time_ms = 0;
+    // Поиск на время соперника: поток, позиция и цвет, для которых ищется ход, время начала и результат.
+    thread ponder_thread;
+    vector<vector<POS_T>> ponder_mtx;
+    bool ponder_color = false;
+    chrono::steady_clock::time_point ponder_start;
+    vector<move_pos> ponder_result;
+    atomic<bool> ponder_done{ false };
+    // Фоновый поиск хода (start_search): поток, признак окончания и результат.
+    thread search_thread;
+    atomic<bool> search_done{ false };
+    vector<move_pos> search_result;
+    // Эндшпильная база (отображённый в память файл), общая для всех потоков.
+    unique_ptr<Tablebase> tablebase = make_unique<Tablebase>();
+    // Дебютная книга (отображённый в память файл).
+    unique_ptr<Opening_book> book = make_unique<Opening_book>();
+    // Генератор случайных чисел для выбора хода из книги.
+    default_random_engine book_rand_eng;
+};
@@ -0,0 +1,135 @@
+#pragma once
+#include <stddef.h>
+#include <string>
+#include <utility>
+using namespace std;
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Класс Mapped_file отображает файл в память только для чтения.
+// Данные не копируются и не разбираются: файлы движка (эндшпильные базы, дебютная книга)
+// записаны так, что ими можно пользоваться прямо из отображённой памяти.
+class Mapped_file
+{
+public:
+    Mapped_file() = default;
+
+    Mapped_file(const Mapped_file&) = delete;
+    Mapped_file& operator=(const Mapped_file&) = delete;
+
+    Mapped_file(Mapped_file&& other) noexcept
+    {
+        swap_with(other);
+    }
+
+    Mapped_file& operator=(Mapped_file&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            swap_with(other);
+        }
+        return *this;
+    }
+
+    ~Mapped_file()
+    {
+        close();
+    }
+
+    // Открывает файл, возвращает false, если файл не удалось открыть или он пустой
+    bool open(const string& path)
+    {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            mapping = nullptr;
+            return false;
+        }
+        bytes = static_cast<const char*>(view);
+        length = size_t(file_size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+            return false;
+        bytes = static_cast<const char*>(view);
+        length = size_t(st.st_size);
+#endif
+        return true;
+    }
+
+    void close()
+    {
+        if (!bytes)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(bytes);
+        CloseHandle(mapping);
+        mapping = nullptr;
+#else
+        munmap(const_cast<char*>(bytes), length);
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const char* data() const
+    {
+        return bytes;
+    }
+
+    size_t size() const
+    {
+        return length;
+    }
+
+private:
+    void swap_with(Mapped_file& other)
+    {
+        swap(bytes, other.bytes);
+        swap(length, other.length);
+#ifdef _WIN32
+        swap(mapping, other.mapping);
+#endif
+    }
+
+    const char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+#endif
+};
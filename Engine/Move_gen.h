@@ -0,0 +1,347 @@
+#pragma once
+#include <vector>
+using namespace std;
+
+#include "../Models/Position.h"
+
+// Максимальное число ходов в одной позиции (с запасом: 12 фигур по 13 клеток на диагоналях)
+const int MAX_TURNS = 192;
+
+// Направления по диагоналям: вверх-влево, вверх-вправо, вниз-влево, вниз-вправо.
+// Противоположное направление для dir равно 3 - dir.
+enum Direction
+{
+    UP_LEFT = 0,
+    UP_RIGHT = 1,
+    DOWN_LEFT = 2,
+    DOWN_RIGHT = 3
+};
+
+// Список ходов фиксированной ёмкости, который заполняет генератор (размещается на стеке вызывающего кода)
+struct Move_list
+{
+    sq_move moves[MAX_TURNS];
+    int size = 0;
+    bool have_beats = false; // Содержит ли список удары
+
+    void clear()
+    {
+        size = 0;
+        have_beats = false;
+    }
+
+    void add(const int from, const int to, const int cap = -1)
+    {
+        moves[size++] = sq_move(from, to, cap);
+    }
+
+    bool empty() const
+    {
+        return size == 0;
+    }
+
+    sq_move* begin()
+    {
+        return moves;
+    }
+
+    sq_move* end()
+    {
+        return moves + size;
+    }
+
+    const sq_move* begin() const
+    {
+        return moves;
+    }
+
+    const sq_move* end() const
+    {
+        return moves + size;
+    }
+
+    sq_move& operator[](const int i)
+    {
+        return moves[i];
+    }
+};
+
+// Класс Move_gen генерирует ходы по битовым маскам позиции.
+// Простые шашки обрабатываются сдвигами масок сразу для всех фигур,
+// дамки - по заранее посчитанным таблицам диагональных лучей.
+class Move_gen
+{
+public:
+    // Все ходы стороны color: только удары, если они есть, иначе тихие ходы.
+    static void find_turns(const Position& pos, const bool color, Move_list& list)
+    {
+        const Tables& t = tables();
+        list.clear();
+        const BB_T occ = pos.occupied();
+        const BB_T empty = ~occ;
+        const BB_T enemy = pos.pieces[!color];
+        const BB_T men = pos.men(color);
+
+        // Удары простыми шашками (бить можно во всех четырёх направлениях)
+        for (int dir = 0; dir < 4; ++dir)
+        {
+            BB_T targets = shift(shift(men, dir) & enemy, dir) & empty;
+            while (targets)
+            {
+                const int to = pop_lsb(targets);
+                const int cap = t.neighbor[to][3 - dir];
+                list.add(t.neighbor[cap][3 - dir], to, cap);
+            }
+        }
+        // Удары дамками
+        for (BB_T kings = pos.kings(color); kings;)
+        {
+            add_king_beats(t, pop_lsb(kings), occ, enemy, list);
+        }
+        if (!list.empty())
+        {
+            list.have_beats = true;
+            return;
+        }
+
+        // Тихие ходы простых шашек: белые ходят вверх, чёрные - вниз
+        for (int dir = (color ? DOWN_LEFT : UP_LEFT), last = dir + 1; dir <= last; ++dir)
+        {
+            BB_T targets = shift(men, dir) & empty;
+            while (targets)
+            {
+                const int to = pop_lsb(targets);
+                list.add(t.neighbor[to][3 - dir], to);
+            }
+        }
+        // Тихие ходы дамок
+        for (BB_T kings = pos.kings(color); kings;)
+        {
+            const int from = pop_lsb(kings);
+            for (int dir = 0; dir < 4; ++dir)
+            {
+                BB_T targets = t.ray[from][dir] & ~shadow(t, t.ray[from][dir] & occ, dir);
+                while (targets)
+                {
+                    list.add(from, pop_lsb(targets));
+                }
+            }
+        }
+    }
+
+    // Ходы одной фигуры на клетке sq: удары, если они есть, иначе тихие ходы.
+    static void find_turns(const Position& pos, const int sq, Move_list& list)
+    {
+        const Tables& t = tables();
+        list.clear();
+        const BB_T bit = BB_T(1) << sq;
+        if (!(pos.occupied() & bit))
+            return;
+        const bool color = (pos.pieces[1] & bit) != 0;
+        const BB_T occ = pos.occupied();
+        const BB_T enemy = pos.pieces[!color];
+        const bool is_queen = (pos.queens & bit) != 0;
+
+        if (is_queen)
+        {
+            add_king_beats(t, sq, occ, enemy, list);
+        }
+        else
+        {
+            for (int dir = 0; dir < 4; ++dir)
+            {
+                const int cap = t.neighbor[sq][dir];
+                if (cap == -1 || !(enemy & (BB_T(1) << cap)))
+                    continue;
+                const int to = t.neighbor[cap][dir];
+                if (to != -1 && !(occ & (BB_T(1) << to)))
+                    list.add(sq, to, cap);
+            }
+        }
+        if (!list.empty())
+        {
+            list.have_beats = true;
+            return;
+        }
+
+        if (is_queen)
+        {
+            for (int dir = 0; dir < 4; ++dir)
+            {
+                BB_T targets = t.ray[sq][dir] & ~shadow(t, t.ray[sq][dir] & occ, dir);
+                while (targets)
+                {
+                    list.add(sq, pop_lsb(targets));
+                }
+            }
+        }
+        else
+        {
+            for (int dir = (color ? DOWN_LEFT : UP_LEFT), last = dir + 1; dir <= last; ++dir)
+            {
+                const int to = t.neighbor[sq][dir];
+                if (to != -1 && !(occ & (BB_T(1) << to)))
+                    list.add(sq, to);
+            }
+        }
+    }
+
+    // Перебор всех полных ходов стороны color (цепочка ударов - один ход).
+    // Для каждого хода вызывается f(позиция после хода, цепочка), позиция восстанавливается после перебора.
+    template <class F>
+    static void for_each_turn(Position& pos, const bool color, F&& f)
+    {
+        vector<sq_move> chain;
+        expand(pos, color, -1, chain, f);
+    }
+
+    // Выполняет на позиции ход-цепочку, найденный движком (Logic::find_best_turns).
+    static void apply_turns(Position& pos, const vector<move_pos>& turns)
+    {
+        for (const move_pos& turn : turns)
+        {
+            const sq_move move(sq_index(turn.x, turn.y), sq_index(turn.x2, turn.y2),
+                               (turn.xb != -1 ? sq_index(turn.xb, turn.yb) : -1));
+            Undo_info undo;
+            pos.make(move, undo);
+        }
+    }
+
+    // Случайный ход стороны color (для разнообразия партий), цепочка ударов доигрывается случайно.
+    template <class Rand>
+    static void random_turn(Position& pos, const bool color, Rand& rng)
+    {
+        Move_list list;
+        find_turns(pos, color, list);
+        while (!list.empty())
+        {
+            const sq_move move = list[int(rng() % unsigned(list.size))];
+            Undo_info undo;
+            pos.make(move, undo);
+            if (!list.have_beats)
+                break;
+            find_turns(pos, move.to, list);
+            if (!list.have_beats)
+                break;
+        }
+    }
+
+    // Сдвиг всех фигур маски на одну клетку в направлении dir.
+    // Чётные строки доски занимают биты 0x0F0F0F0F, нечётные - 0xF0F0F0F0, поэтому величина сдвига зависит от чётности строки.
+    static BB_T shift(const BB_T bb, const int dir)
+    {
+        const BB_T even_rows = 0x0F0F0F0F, odd_rows = 0xF0F0F0F0;
+        const BB_T left_col = 0x11111111, right_col = 0x88888888;
+        const BB_T top_row = 0x0000000F, bottom_row = 0xF0000000;
+        switch (dir)
+        {
+        case UP_LEFT:
+            return ((bb & even_rows & ~top_row) >> 4) | ((bb & odd_rows & ~left_col) >> 5);
+        case UP_RIGHT:
+            return ((bb & even_rows & ~top_row & ~right_col) >> 3) | ((bb & odd_rows) >> 4);
+        case DOWN_LEFT:
+            return ((bb & even_rows) << 4) | ((bb & odd_rows & ~left_col & ~bottom_row) << 3);
+        default:
+            return ((bb & even_rows & ~right_col) << 5) | ((bb & odd_rows & ~bottom_row) << 4);
+        }
+    }
+
+private:
+    // Перебор продолжений хода для for_each_turn: sq - клетка фигуры, продолжающей цепочку ударов (иначе -1).
+    template <class F>
+    static void expand(Position& pos, const bool color, const int sq, vector<sq_move>& chain, F& f)
+    {
+        Move_list list;
+        if (sq != -1)
+            find_turns(pos, sq, list);
+        else
+            find_turns(pos, color, list);
+        // Цепочка ударов закончилась
+        if (sq != -1 && !list.have_beats)
+        {
+            f(pos, chain);
+            return;
+        }
+        for (const sq_move turn : list)
+        {
+            Undo_info undo;
+            pos.make(turn, undo);
+            chain.push_back(turn);
+            if (list.have_beats)
+                expand(pos, color, turn.to, chain, f);
+            else
+                f(pos, chain);
+            chain.pop_back();
+            pos.unmake(turn, undo);
+        }
+    }
+
+    // Таблицы соседних клеток и диагональных лучей, считаются один раз при первом обращении
+    struct Tables
+    {
+        int8_t neighbor[32][4]; // Соседняя клетка в направлении (или -1 у края доски)
+        BB_T ray[32][4];        // Все клетки от данной (не включая её) до края доски в направлении
+
+        Tables()
+        {
+            for (int sq = 0; sq < 32; ++sq)
+            {
+                for (int dir = 0; dir < 4; ++dir)
+                {
+                    const BB_T next = shift(BB_T(1) << sq, dir);
+                    neighbor[sq][dir] = int8_t(next ? lsb_index(next) : -1);
+                }
+            }
+            for (int sq = 0; sq < 32; ++sq)
+            {
+                for (int dir = 0; dir < 4; ++dir)
+                {
+                    ray[sq][dir] = 0;
+                    for (int cur = neighbor[sq][dir]; cur != -1; cur = neighbor[cur][dir])
+                        ray[sq][dir] |= BB_T(1) << cur;
+                }
+            }
+        }
+    };
+
+    static const Tables& tables()
+    {
+        static const Tables t;
+        return t;
+    }
+
+    // Ближайшая к началу луча фигура среди blockers: при движении вверх индексы убывают, вниз - возрастают
+    static int nearest(const BB_T blockers, const int dir)
+    {
+        return (dir == UP_LEFT || dir == UP_RIGHT) ? msb_index(blockers) : lsb_index(blockers);
+    }
+
+    // Клетки луча, закрытые ближайшей фигурой (сама фигура и всё за ней)
+    static BB_T shadow(const Tables& t, const BB_T blockers, const int dir)
+    {
+        if (!blockers)
+            return 0;
+        const int sq = nearest(blockers, dir);
+        return (BB_T(1) << sq) | t.ray[sq][dir];
+    }
+
+    // Удары дамки с клетки from: первая фигура на луче должна быть вражеской,
+    // а приземлиться можно на любую свободную клетку за ней до следующей фигуры.
+    static void add_king_beats(const Tables& t, const int from, const BB_T occ, const BB_T enemy, Move_list& list)
+    {
+        for (int dir = 0; dir < 4; ++dir)
+        {
+            const BB_T blockers = t.ray[from][dir] & occ;
+            if (!blockers)
+                continue;
+            const int cap = nearest(blockers, dir);
+            if (!(enemy & (BB_T(1) << cap)))
+                continue;
+            BB_T targets = t.ray[cap][dir] & ~shadow(t, t.ray[cap][dir] & occ, dir);
+            while (targets)
+            {
+                list.add(from, pop_lsb(targets), cap);
+            }
+        }
+    }
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "../Models/Position.h"
+#include "Mapped_file.h"
+#include "Move_gen.h"
+
+// Запись дебютной книги: ход из позиции key в позицию next_key встречался weight раз.
+// Ход хранится позицией после него, поэтому цепочка ударов - одна запись, а при чтении
+// ход восстанавливается перебором ходов позиции (ход, которого в позиции нет, не будет сыгран).
+struct Book_entry
+{
+    uint64_t key = 0;      // Ключ позиции вместе со стороной, которая ходит (Opening_book::book_key)
+    uint64_t next_key = 0; // Position::key после хода
+    uint32_t weight = 0;   // Вес хода: чем больше, тем чаще он выбирается
+    uint32_t reserved = 0;
+};
+
+// Класс Opening_book - дебютная книга: для позиций начала партии хранит ходы с весами.
+// Файл отображается в память и используется без разбора: записи отсортированы по ключу,
+// ходы позиции находятся двоичным поиском.
+//
+// Формат файла: заголовок (File_header), затем count записей Book_entry, отсортированных по key.
+class Opening_book
+{
+public:
+    // Загрузка книги из файла, false - файла нет или формат не подходит
+    bool load(const string& path)
+    {
+        entries = nullptr;
+        count = 0;
+        if (!file.open(path) || file.size() < sizeof(File_header))
+            return false;
+        File_header header;
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 ||
+            sizeof(header) + header.count * sizeof(Book_entry) > file.size())
+            return false;
+        entries = reinterpret_cast<const Book_entry*>(file.data() + sizeof(header));
+        count = header.count;
+        return true;
+    }
+
+    bool loaded() const
+    {
+        return count > 0;
+    }
+
+    // Количество ходов в книге
+    size_t size() const
+    {
+        return count;
+    }
+
+    // Ключ позиции в книге: учитывает сторону, которая ходит
+    static uint64_t book_key(const Position& pos, const bool color)
+    {
+        return pos.key ^ zobrist().side[color];
+    }
+
+    // Ход из книги для стороны color: выбирается случайно, с вероятностью, пропорциональной весу.
+    // Ход записывается цепочкой в chain, false - позиции нет в книге.
+    template <class Rand>
+    bool find_turn(Position pos, const bool color, Rand& rand_eng, vector<sq_move>& chain) const
+    {
+        const uint64_t key = book_key(pos, color);
+        const Book_entry* first = lower_bound(entries, entries + count, key,
+                                              [](const Book_entry& e, const uint64_t k) { return e.key < k; });
+        const Book_entry* last = first;
+        uint64_t total = 0;
+        for (; last != entries + count && last->key == key; ++last)
+            total += last->weight;
+        chain.clear();
+        if (!total)
+            return false;
+        uint64_t pick = uniform_int_distribution<uint64_t>(0, total - 1)(rand_eng);
+        const Book_entry* chosen = first;
+        for (; chosen + 1 != last && pick >= chosen->weight; ++chosen)
+            pick -= chosen->weight;
+        Move_gen::for_each_turn(pos, color, [&](const Position& next, const vector<sq_move>& turns) {
+            if (next.key == chosen->next_key)
+                chain = turns;
+        });
+        return !chain.empty();
+    }
+
+    // Сортирует записи по ключу и объединяет одинаковые ходы (key и next_key), складывая их веса.
+    static void merge(vector<Book_entry>& list)
+    {
+        sort(list.begin(), list.end(), [](const Book_entry& a, const Book_entry& b) {
+            return a.key != b.key ? a.key < b.key : a.next_key < b.next_key;
+        });
+        vector<Book_entry> merged;
+        for (const Book_entry& e : list)
+        {
+            if (!merged.empty() && merged.back().key == e.key && merged.back().next_key == e.next_key)
+                merged.back().weight += e.weight;
+            else
+                merged.push_back(e);
+        }
+        list.swap(merged);
+    }
+
+    // Запись книги в файл (записи предварительно объединяются merge).
+    static bool save(vector<Book_entry> list, const string& path)
+    {
+        merge(list);
+        FILE* out = fopen(path.c_str(), "wb");
+        if (!out)
+            return false;
+        File_header header;
+        memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.count = uint32_t(list.size());
+        header.reserved = 0;
+        bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+        ok = ok && fwrite(list.data(), sizeof(Book_entry), list.size(), out) == list.size();
+        return fclose(out) == 0 && ok;
+    }
+
+private:
+    struct File_header
+    {
+        char magic[8];
+        uint32_t count; // Количество записей
+        uint32_t reserved;
+    };
+
+    static constexpr char MAGIC[8] = { 'C', 'K', 'B', 'K', '0', '0', '1', '\0' };
+
+    Mapped_file file;
+    // Записи книги в отображённом файле
+    const Book_entry* entries = nullptr;
+    size_t count = 0;
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+#include <cstdlib>
+using namespace std;
+
+// Оценка позиции с точки зрения стороны, которая ходит (поиск - негамакс: оценка хода для соперника
+// равна оценке с обратным знаком). Шкала целая и симметричная: 0 - равенство или ничья.
+//
+// |оценка| <= EVAL_SCALE           - оценка по соотношению сил (Evaluator)
+// SCORE_WIN - n                    - выигрыш через n полуходов от корня поиска
+// -(SCORE_WIN - n)                 - проигрыш через n полуходов
+// SCORE_INF                        - больше любой оценки, граница полного окна
+//
+// Договорённость о границах (fail-soft): поиск в окне (alpha, beta) возвращает v, причём
+// v <= alpha - истинная оценка не больше v, v >= beta - истинная оценка не меньше v, иначе v точна.
+using Score = int32_t;
+
+const Score EVAL_SCALE = 1000000;
+const Score SCORE_WIN = 100000000;
+const Score SCORE_INF = SCORE_WIN + 1;
+// Оценки, не меньшие по модулю, означают известный результат партии (с запасом на глубину поиска и базы)
+const Score SCORE_DECISIVE = SCORE_WIN - 1000;
+
+// Выигрыш и проигрыш через ply полуходов от корня
+inline Score win_in(const int ply)
+{
+    return SCORE_WIN - ply;
+}
+
+inline Score loss_in(const int ply)
+{
+    return -(SCORE_WIN - ply);
+}
+
+inline bool is_decisive(const Score score)
+{
+    return abs(score) >= SCORE_DECISIVE;
+}
+
+// В таблице транспозиций расстояние до конца партии хранится от самого узла, а не от корня:
+// одна и та же позиция встречается на разных расстояниях от корня и в разных поисках.
+inline Score score_to_table(const Score score, const int ply)
+{
+    return score >= SCORE_DECISIVE ? score + ply : (score <= -SCORE_DECISIVE ? score - ply : score);
+}
+
+inline Score score_from_table(const Score score, const int ply)
+{
+    return score >= SCORE_DECISIVE ? score - ply : (score <= -SCORE_DECISIVE ? score + ply : score);
+}
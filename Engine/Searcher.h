@@ -0,0 +1,630 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "../Models/Move.h"
+#include "../Models/Position.h"
+#include "Evaluator.h"
+#include "Hash_table.h"
+#include "Move_gen.h"
+#include "Score.h"
+#include "Split_point.h"
+#include "Tablebase.h"
+
+// Предельная глубина итеративного углубления в режиме ограничения времени на ход
+const int MAX_SEARCH_DEPTH = 60;
+// Минимальная оставшаяся глубина узла, начиная с которой его ходы раздаются свободным потокам
+const int SPLIT_MIN_DRAFT = 3;
+
+// Класс Searcher выполняет поиск лучшего хода в одном потоке.
+// Всё состояние поиска (ходы-убийцы, история, восстановление цепочки ходов) принадлежит объекту,
+// общими между потоками являются только таблица транспозиций и флаг остановки.
+class Searcher
+{
+public:
+    Searcher(const string& scoring_mode, const string& optimization, const unsigned seed, const bool quiescence = true)
+        : rand_eng(seed), quiescence(quiescence)
+    {
+        // Режим оценки и отсечения выбираются один раз: дальше поиск идёт по коду, специализированному
+        // при компиляции, без сравнений строк в узлах дерева.
+        const bool pruning = (optimization != "O0");
+        switch (parse_scoring(scoring_mode))
+        {
+        case Scoring::NUMBER_AND_POTENTIAL:
+            pruning ? bind<Scoring::NUMBER_AND_POTENTIAL, true>() : bind<Scoring::NUMBER_AND_POTENTIAL, false>();
+            break;
+        default:
+            pruning ? bind<Scoring::NUMBER_ONLY, true>() : bind<Scoring::NUMBER_ONLY, false>();
+            break;
+        }
+    }
+
+    // Подготовка к поиску с общей таблицей транспозиций и флагом остановки (по истечении времени).
+    // Если передан пул потоков, ходы узлов раздаются свободным потокам (Young Brothers Wait).
+    // cancel_flag - флаг отмены поиска вызывающим кодом: поиск его только читает.
+    void new_search(Hash_table* table, atomic<bool>* stop_flag, Split_pool* split_pool = nullptr,
+                    const atomic<bool>* cancel_flag = nullptr)
+    {
+        hash_table = table;
+        stop = stop_flag;
+        cancel = cancel_flag;
+        pool = split_pool;
+        active_sp = nullptr;
+        prev_line.clear();
+        nodes = qnodes = cutoffs = hash_cutoffs = tb_hits = 0;
+        // Ходы-убийцы относятся к конкретной позиции, а историю ходов только ослабляем.
+        for (auto& killer : killers)
+            killer[0] = killer[1] = sq_move();
+        for (auto& from : history)
+            for (auto& to : from)
+                for (int& value : to)
+                    value /= 2;
+    }
+
+    // Эндшпильная база, которой поиск заменяет перебор позиций с малым числом фигур (nullptr - без базы).
+    void set_tablebase(const Tablebase* tb)
+    {
+        tablebase = tb;
+    }
+
+    // Поиск лучшего хода стороны color на глубину depth в окне (alpha, beta), возвращает оценку лучшего хода
+    // с точки зрения color. Если оценка вышла за окно, она только граница (см. Score.h),
+    // а лучший ход недостоверен: нужен повторный поиск.
+    Score search(Position& pos, const bool color, const int depth, const Score alpha = -SCORE_INF,
+                 const Score beta = SCORE_INF)
+    {
+        Max_depth = depth;
+        return (this->*root_search)(pos, color, -1, 0, alpha, beta);
+    }
+
+    // Ключ узла в таблице транспозиций: учитывает сторону, которая ходит,
+    // и фигуру, продолжающую цепочку ударов (sq, иначе -1). Оценки даются с точки зрения ходящей стороны,
+    // поэтому не зависят от того, за какой цвет играет бот.
+    static uint64_t node_key(const Position& pos, const bool color, const int sq)
+    {
+        const Zobrist& z = zobrist();
+        return pos.key ^ z.side[color] ^ (sq != -1 ? z.chain[sq] : 0);
+    }
+
+    // Работа помощника в точке разделения, созданной другим потоком.
+    void help(Split_point& sp)
+    {
+        Max_depth = sp.master->Max_depth;
+        Position pos = sp.pos;
+        active_sp = &sp;
+        (this->*split_search)(sp, pos);
+        active_sp = nullptr;
+    }
+
+    // Собирает последовательность ходов из состояний, сохранённых find_first_best_turn,
+    // и запоминает её для упорядочивания ходов в следующей итерации.
+    vector<move_pos> collect_best_turns()
+    {
+        int cur_state = 0;
+        vector<move_pos> res;
+        prev_line.clear();
+        do
+        {
+            res.push_back(next_move[cur_state]);
+            prev_line.push_back(next_sq_move[cur_state]);
+            cur_state = next_best_state[cur_state];
+        } while (cur_state != -1 && next_move[cur_state].x != -1);
+        return res;
+    }
+
+private:
+    // Выбирает точки входа поиска для режима оценки S; PRUNE - включены ли альфа-бета отсечения (не "O0").
+    template <Scoring S, bool PRUNE>
+    void bind()
+    {
+        root_search = &Searcher::find_first_best_turn<S, PRUNE>;
+        split_search = &Searcher::work_split<S, PRUNE>;
+    }
+
+    // Функция find_first_best_turn ищет лучший ход среди последовательных ударов для конкретной фигуры.
+    // Она используется для реализации цепочки ударов, когда после первого удара возможны последующие.
+    //
+    // Аргументы:
+    // - pos: текущая позиция на доске.
+    // - color: цвет текущего игрока.
+    // - sq: клетка фигуры, продолжающей цепочку ударов (иначе -1).
+    // - state: индекс текущего состояния в последовательности ходов.
+    // - alpha: текущий параметр альфа для отсечения в алгоритме негамакс.
+    // - beta: текущий параметр бета (окно поиска в корне задаёт итеративное углубление).
+    // Оценка возвращается с точки зрения color.
+    template <Scoring S, bool PRUNE>
+    Score find_first_best_turn(Position& pos, const bool color, const int sq, size_t state,
+                               const Score alpha = -SCORE_INF, const Score beta = SCORE_INF)
+    {
+        // В начале поиска очищаем векторы, хранящие индексы для восстановления последовательности ходов.
+        if (state == 0)
+        {
+            next_best_state.clear();
+            next_move.clear();
+            next_sq_move.clear();
+        }
+        // Регистрируем новое состояние: добавляем фиктивное значение -1.
+        next_best_state.push_back(-1);
+        // Регистрируем ход с невалидными координатами по умолчанию.
+        next_move.emplace_back(-1, -1, -1, -1);
+        next_sq_move.emplace_back();
+
+        // Изначально лучший найденный счет меньше любой оценки.
+        Score best_score = -SCORE_INF;
+
+        // Если state не равен 0, ищем ходы для конкретной фигуры на клетке sq, иначе - для всех фигур.
+        Move_list turns_now;
+        if (state != 0)
+            Move_gen::find_turns(pos, sq, turns_now);
+        else
+            Move_gen::find_turns(pos, color, turns_now);
+        bool have_beats_now = turns_now.have_beats;
+
+        // Если ударов нет и мы находимся не в начале цепочки, переключаемся на стандартный минимакс.
+        if (!have_beats_now && state != 0)
+        {
+            // Переключаем сторону, так как цепочка ударов завершена.
+            return -find_best_turns_rec<S, PRUNE>(pos, 1 - color, 0, -beta, -alpha);
+        }
+
+        // Перемешиваем ходы (используем генератор случайных чисел), чтобы среди равноценных ходов
+        // выбор был случайным, затем упорядочиваем их. Ходы лучшей цепочки предыдущей итерации перебираем первыми.
+        shuffle(turns_now.begin(), turns_now.end(), rand_eng);
+        order_turns(pos, color, 0, sq_move(), turns_now);
+        for (const sq_move turn : prev_line)
+        {
+            auto it = find(turns_now.begin(), turns_now.end(), turn);
+            if (it != turns_now.end())
+                rotate(turns_now.begin(), it, it + 1);
+        }
+
+        // Перебираем все возможные ходы для данной фигуры.
+        for (int i = 0; i < turns_now.size; ++i)
+        {
+            const sq_move turn = turns_now[i];
+            // Определяем индекс следующего состояния (для восстановления последовательности ходов).
+            size_t next_state = next_move.size();
+            Score score;
+            const Score cur_alpha = max(alpha, best_score);
+
+            // Выполняем ход на месте, после оценки он будет отменён.
+            Undo_info undo;
+            pos.make(turn, undo);
+            // Если возможен удар, продолжаем цепочку ударов (игрок не переключается).
+            if (have_beats_now)
+            {
+                // Рекурсивно ищем лучший последующий удар.
+                score = find_first_best_turn<S, PRUNE>(pos, color, turn.to, next_state, cur_alpha, beta);
+            }
+            else if (PRUNE && i > 0 && beta - cur_alpha > 1)
+            {
+                // Лучший ход уже найден: остальные сначала проверяем нулевым окном (только "лучше ли он"),
+                // и считаем точно, только если ход оказался лучше.
+                score = -find_best_turns_rec<S, PRUNE>(pos, 1 - color, 0, -cur_alpha - 1, -cur_alpha);
+                if (score > cur_alpha && score < beta && !aborted())
+                    score = -find_best_turns_rec<S, PRUNE>(pos, 1 - color, 0, -beta, -cur_alpha);
+            }
+            else
+            {
+                // Если ударов нет, переключаем игрока: оценка соперника берётся с обратным знаком.
+                score = -find_best_turns_rec<S, PRUNE>(pos, 1 - color, 0, -beta, -cur_alpha);
+            }
+            pos.unmake(turn, undo);
+
+            // Если полученный счет лучше текущего лучшего, обновляем лучший счет и запоминаем ход.
+            if (score > best_score)
+            {
+                best_score = score;
+                next_best_state[state] = (have_beats_now ? int(next_state) : -1);
+                next_move[state] = turn.to_move_pos();
+                next_sq_move[state] = turn;
+            }
+            // Оценка не ниже верхней границы окна: точнее её узнает повторный поиск с более широким окном.
+            if (PRUNE && best_score >= beta)
+                break;
+        }
+        // Возвращаем лучший найденный счет для данной цепочки ходов.
+        return best_score;
+    }
+
+    // Функция find_best_turns_rec реализует рекурсивный поиск лучшего хода по алгоритму негамакс
+    // с отсечениями альфа-бета: оценка узла дана с точки зрения ходящей стороны и равна максимуму
+    // оценок ходов, а оценка хода - оценке позиции после него для соперника с обратным знаком.
+    // depth + 1 - расстояние узла от корня в полуходах (по нему считаются оценки выигрыша и проигрыша).
+    //
+    // Аргументы:
+    // - pos: текущая позиция на доске.
+    // - color: цвет текущего игрока.
+    // - depth: текущая глубина рекурсии.
+    // - alpha: значение альфа для отсечения.
+    // - beta: значение бета для отсечения.
+    // - sq: если задана, поиск ведётся для фигуры на этой клетке (цепочка ударов).
+    template <Scoring S, bool PRUNE>
+    Score find_best_turns_rec(Position& pos, const bool color, const size_t depth, const Score alpha,
+                              const Score beta, const int sq = -1)
+    {
+        // Время от времени проверяем, не истекло ли время на ход. После остановки оценки
+        // недостоверны: они не сохраняются и отбрасываются в find_best_turns.
+        if ((++nodes & 1023) == 0 && time_limited && chrono::steady_clock::now() >= deadline)
+            *stop = true;
+        if (aborted())
+            return 0;
+
+        const int ply = int(depth) + 1;
+        // Позиция есть в эндшпильной базе: результат при правильной игре известен точно.
+        // Ничья оценивается как равенство сил, выигрыш и проигрыш - с расстоянием до конца партии.
+        int8_t tb_value;
+        if (tablebase && sq == -1 && tablebase->probe(pos, color, tb_value))
+        {
+            ++tb_hits;
+            if (tb_value == TB_DRAW)
+                return 0;
+            return (tb_win(tb_value) ? win_in(ply + tb_distance(tb_value)) : loss_in(ply + tb_distance(tb_value)));
+        }
+
+        // Базовый случай: если достигнута максимальная глубина поиска, возвращаем оценку позиции
+        // (или досчитываем обязательные удары, если позиция не спокойная).
+        if (int(depth) == Max_depth)
+        {
+            if (quiescence)
+                return quiescence_search<S, PRUNE>(pos, color, depth, alpha, beta);
+            return leaf_score<S>(pos, color, ply);
+        }
+
+        // Проверяем таблицу транспозиций.
+        const uint64_t key = node_key(pos, color, sq);
+        const int draft = Max_depth - int(depth);
+        sq_move hash_move;
+        if (PRUNE)
+        {
+            Hash_entry entry;
+            if (hash_table->probe(key, entry))
+            {
+                hash_move = entry.best;
+                const Score score = score_from_table(entry.score, ply);
+                if ((exact_draft ? entry.draft == draft : entry.draft >= draft) &&
+                    (entry.bound == Bound::EXACT || (entry.bound == Bound::LOWER && score >= beta) ||
+                     (entry.bound == Bound::UPPER && score <= alpha)))
+                {
+                    ++hash_cutoffs;
+                    return score;
+                }
+            }
+        }
+
+        // Список ходов узла хранится на стеке, общий вектор turns в поиске не используется.
+        Move_list turns_now;
+        // Если передана клетка sq, ищем ходы для конкретной фигуры (для цепочки ударов).
+        if (sq != -1)
+        {
+            Move_gen::find_turns(pos, sq, turns_now);
+        }
+        else
+        {
+            // Иначе ищем ходы для всех фигур текущего игрока.
+            Move_gen::find_turns(pos, color, turns_now);
+        }
+        bool have_beats_now = turns_now.have_beats; // Флаг наличия ударов.
+
+        // Если в цепочке ударов удары закончились (флаг false) и координаты заданы,
+        // переключаем игрока и увеличиваем глубину рекурсии.
+        if (!have_beats_now && sq != -1)
+        {
+            return -find_best_turns_rec<S, PRUNE>(pos, 1 - color, depth + 1, -beta, -alpha);
+        }
+
+        // Если нет вообще возможных ходов, ходящая сторона проиграла.
+        if (turns_now.empty())
+            return loss_in(ply);
+
+        // Упорядочиваем ходы: ход из таблицы транспозиций, удары, превращения, ходы-убийцы, история.
+        order_turns(pos, color, depth, hash_move, turns_now);
+
+        // Инициализируем границы окна и лучшую оценку узла.
+        Node_bounds bounds;
+        bounds.alpha = alpha;
+        bounds.beta = beta;
+        bool is_cutoff = false;
+
+        // Перебираем все найденные ходы.
+        for (int i = 0; i < turns_now.size; ++i)
+        {
+            const sq_move turn = turns_now[i];
+            const Score score =
+                search_child<S, PRUNE>(pos, turn, color, depth, sq, have_beats_now, bounds.alpha, bounds.beta, i > 0);
+            if (aborted())
+                return 0;
+
+            // Обновляем лучшую оценку, параметр альфа и лучший ход узла.
+            // Если обнаружено условие отсечения (alpha >= beta), прекращаем перебор ветвей.
+            if (bounds.update(score, turn) && PRUNE)
+            {
+                remember_cutoff(turn, color, depth, draft);
+                is_cutoff = true;
+                break;
+            }
+
+            // Первый ход просчитан без отсечения: оставшиеся ходы можно раздать свободным потокам.
+            if (i == 0 && pool && turns_now.size > 1 && draft >= SPLIT_MIN_DRAFT && pool->has_idle())
+            {
+                Split_point sp;
+                sp.pos = pos;
+                sp.color = color;
+                sp.depth = depth;
+                sp.sq = sq;
+                sp.have_beats = have_beats_now;
+                sp.turns = &turns_now;
+                sp.master = this;
+                sp.parent = active_sp;
+                sp.next = 1;
+                sp.bounds = bounds;
+                if (pool->recruit(sp))
+                {
+                    // Владелец узла тоже разбирает ходы, а затем ждёт помощников.
+                    active_sp = &sp;
+                    work_split<S, PRUNE>(sp, pos);
+                    sp.wait_slaves();
+                    active_sp = sp.parent;
+                    if (aborted())
+                        return 0;
+                    bounds = sp.bounds;
+                    is_cutoff = sp.cutoff;
+                    break;
+                }
+            }
+        }
+        const Score res = bounds.best_score;
+        const sq_move best_turn = bounds.best_turn;
+        if (is_cutoff)
+            ++cutoffs;
+        // Оценки возвращаются без округления до границ окна (fail-soft): оценка вне окна является
+        // верной границей истинной оценки, поэтому и в таблицу сохраняется она, а не граница окна.
+        if (PRUNE)
+        {
+            const Score stored = score_to_table(res, ply);
+            if (res <= alpha)
+                hash_table->store(key, stored, draft, Bound::UPPER, best_turn);
+            else if (res >= beta)
+                hash_table->store(key, stored, draft, Bound::LOWER, best_turn);
+            else
+                hash_table->store(key, stored, draft, Bound::EXACT, best_turn);
+        }
+        return res;
+    }
+
+    // Поиск за горизонтом: удары обязательны, поэтому, пока у ходящей стороны есть удары, перебираются
+    // все они (включая продолжения цепочек), а оценка берётся только в спокойной позиции.
+    // Цепочки ударов конечны (каждый удар снимает фигуру), поэтому поиск всегда завершается.
+    template <Scoring S, bool PRUNE>
+    Score quiescence_search(Position& pos, const bool color, const size_t depth, const Score alpha, const Score beta,
+                            const int sq = -1)
+    {
+        if ((++qnodes & 1023) == 0 && time_limited && chrono::steady_clock::now() >= deadline)
+            *stop = true;
+        if (aborted())
+            return 0;
+
+        Move_list turns_now;
+        if (sq != -1)
+            Move_gen::find_turns(pos, sq, turns_now);
+        else
+            Move_gen::find_turns(pos, color, turns_now);
+        if (!turns_now.have_beats)
+        {
+            // Цепочка ударов закончилась: ход переходит к сопернику, у которого тоже могут быть удары.
+            if (sq != -1)
+                return -quiescence_search<S, PRUNE>(pos, 1 - color, depth + 1, -beta, -alpha);
+            return leaf_score<S>(pos, color, int(depth) + 1);
+        }
+        order_turns(pos, color, depth, sq_move(), turns_now);
+
+        Node_bounds bounds;
+        bounds.alpha = alpha;
+        bounds.beta = beta;
+        for (const sq_move turn : turns_now)
+        {
+            Undo_info undo;
+            pos.make(turn, undo);
+            const Score score = quiescence_search<S, PRUNE>(pos, color, depth, bounds.alpha, bounds.beta, turn.to);
+            pos.unmake(turn, undo);
+            if (aborted())
+                return 0;
+            if (bounds.update(score, turn) && PRUNE)
+                break;
+        }
+        return bounds.best_score;
+    }
+
+    // Оценка спокойной позиции на горизонте для стороны color: без фигур сторона проиграла,
+    // иначе позицию оценивает Evaluator.
+    template <Scoring S>
+    static Score leaf_score(const Position& pos, const bool color, const int ply)
+    {
+        if (!pos.pieces[color])
+            return loss_in(ply);
+        return Evaluator<S>::calc_score(pos, color);
+    }
+
+    // Выполняет ход, оценивает получившуюся позицию и отменяет ход.
+    // pv_found - в узле уже просчитан хотя бы один ход: тогда ход сначала проверяется нулевым окном
+    // (alpha, alpha + 1) (поиск с главным вариантом), а точная оценка считается,
+    // только если ход оказался лучше уже найденного.
+    template <Scoring S, bool PRUNE>
+    Score search_child(Position& pos, const sq_move turn, const bool color, const size_t depth, const int sq,
+                       const bool have_beats_now, const Score alpha, const Score beta, const bool pv_found = false)
+    {
+        Undo_info undo;
+        pos.make(turn, undo);
+        // Если это обычный ход (без последовательных ударов), переключаем игрока: окно и оценка соперника
+        // берутся с обратным знаком. Если продолжается цепочка ударов, не переключаем игрока,
+        // а передаём новую клетку фигуры.
+        const auto child = [&](const Score a, const Score b) {
+            if (!have_beats_now && sq == -1)
+                return -find_best_turns_rec<S, PRUNE>(pos, 1 - color, depth + 1, -b, -a);
+            return find_best_turns_rec<S, PRUNE>(pos, color, depth, a, b, turn.to);
+        };
+        Score score;
+        if (PRUNE && pv_found && beta - alpha > 1)
+        {
+            score = child(alpha, alpha + 1);
+            if (score > alpha && score < beta && !aborted())
+                score = child(alpha, beta);
+        }
+        else
+            score = child(alpha, beta);
+        pos.unmake(turn, undo);
+        return score;
+    }
+
+    // Тихий ход, вызвавший отсечение, запоминаем как ход-убийцу и поощряем в истории.
+    void remember_cutoff(const sq_move turn, const bool color, const size_t depth, const int draft)
+    {
+        if (turn.cap != -1 || depth > MAX_SEARCH_DEPTH)
+            return;
+        if (killers[depth][0] != turn)
+        {
+            killers[depth][1] = killers[depth][0];
+            killers[depth][0] = turn;
+        }
+        int& value = history[color][turn.from][turn.to];
+        value = min(value + draft * draft, 1 << 20);
+    }
+
+    // Разбор ходов точки разделения: ход берётся под блокировкой, считается с текущим общим окном,
+    // а результат сразу учитывается в общих границах. Используется и владельцем узла, и помощниками.
+    template <Scoring S, bool PRUNE>
+    void work_split(Split_point& sp, Position& pos)
+    {
+        const int draft = Max_depth - int(sp.depth);
+        while (true)
+        {
+            sq_move turn;
+            Score alpha, beta;
+            {
+                lock_guard<mutex> lock(sp.m);
+                if (sp.cutoff || sp.next >= sp.turns->size)
+                    break;
+                turn = sp.turns->moves[sp.next++];
+                alpha = sp.bounds.alpha;
+                beta = sp.bounds.beta;
+            }
+            const Score score =
+                search_child<S, PRUNE>(pos, turn, sp.color, sp.depth, sp.sq, sp.have_beats, alpha, beta, true);
+            // Оценка прерванного поиска недостоверна.
+            if (aborted())
+                break;
+            lock_guard<mutex> lock(sp.m);
+            if (sp.bounds.update(score, turn) && PRUNE && !sp.cutoff)
+            {
+                remember_cutoff(turn, sp.color, sp.depth, draft);
+                sp.cutoff = true;
+            }
+        }
+    }
+
+    // Остановлен ли поиск: по истечении времени, по отмене или из-за отсечения в одной из точек разделения
+    bool aborted() const
+    {
+        return *stop || (cancel && *cancel) || (active_sp && active_sp->aborted());
+    }
+
+    // Упорядочивает ходы по убыванию ожидаемой пользы, чтобы отсечения происходили как можно раньше.
+    // Сортировка устойчивая, поэтому при равных приоритетах сохраняется исходный порядок.
+    void order_turns(const Position& pos, const bool color, const size_t depth, const sq_move hash_move,
+                     Move_list& list) const
+    {
+        int priority[MAX_TURNS];
+        for (int i = 0; i < list.size; ++i)
+        {
+            const sq_move turn = list[i];
+            int value = 0;
+            if (turn == hash_move)
+                value = 1 << 30;
+            else if (turn.cap != -1)
+                // Удары серии - отдельные ходы, длина цепочки до перебора неизвестна, поэтому ценность удара -
+                // побитая фигура: взятие дамки ценнее взятия шашки, бить выгоднее шашкой, чем дамкой.
+                value = (1 << 24) + int((pos.queens >> turn.cap) & 1) * 4 - int((pos.queens >> turn.from) & 1);
+            else if (depth <= MAX_SEARCH_DEPTH && turn == killers[depth][0])
+                value = 1 << 22;
+            else if (depth <= MAX_SEARCH_DEPTH && turn == killers[depth][1])
+                value = (1 << 22) - 1;
+            else
+                value = history[color][turn.from][turn.to];
+            // Превращение в дамку
+            if (!((pos.queens >> turn.from) & 1) && sq_x(turn.to) == (color ? 7 : 0))
+                value += 1 << 23;
+            priority[i] = value;
+        }
+        for (int i = 1; i < list.size; ++i)
+        {
+            const sq_move turn = list[i];
+            const int value = priority[i];
+            int j = i - 1;
+            for (; j >= 0 && priority[j] < value; --j)
+            {
+                list[j + 1] = list[j];
+                priority[j + 1] = priority[j];
+            }
+            list[j + 1] = turn;
+            priority[j + 1] = value;
+        }
+    }
+
+public:
+    // Максимальная глубина рекурсии для алгоритма минимакс.
+    int Max_depth = 0;
+    // Момент, к которому поиск должен завершиться.
+    chrono::steady_clock::time_point deadline;
+    // Проверяется ли сейчас время на ход.
+    bool time_limited = false;
+    // Брать из таблицы транспозиций только оценки той же оставшейся глубины: тогда оценка корня совпадает
+    // с перебором без отсечений на ту же глубину (для сверки в bench).
+    bool exact_draft = false;
+    // Счётчик посещённых узлов.
+    uint64_t nodes = 0;
+    // Счётчики отсечений: альфа-бета и по оценке из таблицы транспозиций.
+    uint64_t cutoffs = 0;
+    uint64_t hash_cutoffs = 0;
+    // Счётчик узлов поиска ударов за горизонтом.
+    uint64_t qnodes = 0;
+    // Счётчик позиций, оценённых по эндшпильной базе.
+    uint64_t tb_hits = 0;
+
+private:
+    // Генератор случайных чисел для перемешивания ходов.
+    default_random_engine rand_eng;
+    // Точки входа поиска, специализированные под режим оценки и отсечения.
+    Score (Searcher::*root_search)(Position&, bool, int, size_t, Score, Score) = nullptr;
+    void (Searcher::*split_search)(Split_point&, Position&) = nullptr;
+    // Досчитывать ли удары за горизонтом поиска.
+    bool quiescence;
+    // Эндшпильная база (nullptr - не используется).
+    const Tablebase* tablebase = nullptr;
+    // Таблица транспозиций, общая для всех потоков.
+    Hash_table* hash_table = nullptr;
+    // Флаг остановки поиска (по истечении времени или по команде главного потока).
+    atomic<bool>* stop = nullptr;
+    // Флаг отмены поиска вызывающим кодом (nullptr - поиск не отменяется).
+    const atomic<bool>* cancel = nullptr;
+    // Пул потоков для раздачи ходов (nullptr - поиск в одном потоке).
+    Split_pool* pool = nullptr;
+    // Самая внутренняя точка разделения, в которой сейчас работает поток.
+    Split_point* active_sp = nullptr;
+    // Вектор для хранения следующего хода в последовательности (используется для восстановления цепочки ударов).
+    vector<move_pos> next_move;
+    // Вектор для хранения индексов следующих состояний (для восстановления цепочки ходов).
+    vector<int> next_best_state;
+    // Те же ходы, что и в next_move, но в индексах клеток.
+    vector<sq_move> next_sq_move;
+    // Лучшая цепочка ходов предыдущей итерации углубления.
+    vector<sq_move> prev_line;
+    // Два последних тихих хода, вызвавших отсечение, для каждой глубины (ходы-убийцы).
+    sq_move killers[MAX_SEARCH_DEPTH + 1][2];
+    // История отсечений тихих ходов: history[цвет][откуда][куда].
+    int history[2][32][32] = {};
+};
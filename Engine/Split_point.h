@@ -0,0 +1,159 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+#include "../Models/Position.h"
+#include "Move_gen.h"
+#include "Score.h"
+
+class Searcher;
+
+// Границы и лучший результат узла негамакса (оценки с точки зрения ходящей стороны).
+struct Node_bounds
+{
+    Score alpha = -SCORE_INF, beta = SCORE_INF;
+    Score best_score = -SCORE_INF;
+    sq_move best_turn;
+
+    // Учитывает оценку очередного хода, возвращает true, если окно схлопнулось (alpha >= beta).
+    bool update(const Score score, const sq_move turn)
+    {
+        if (score > best_score)
+        {
+            best_score = score;
+            best_turn = turn;
+        }
+        alpha = max(alpha, score);
+        return alpha >= beta;
+    }
+};
+
+// Точка разделения (Young Brothers Wait): узел, первый ход которого уже просчитан,
+// а оставшиеся ходы разбирают по одному владелец узла и свободные потоки.
+// Объект живёт на стеке потока-владельца, пока все помощники не закончат работу.
+struct Split_point
+{
+    Position pos;            // Позиция в узле (до выполнения ходов)
+    bool color = false;      // Цвет игрока, который ходит в узле
+    size_t depth = 0;        // Глубина узла
+    int sq = -1;             // Клетка фигуры, продолжающей цепочку ударов (или -1)
+    bool have_beats = false; // Являются ли ходы узла ударами
+    const Move_list* turns = nullptr;
+    Searcher* master = nullptr;       // Поток-владелец узла
+    Split_point* parent = nullptr;    // Внешняя точка разделения владельца (для распространения отмены)
+
+    mutex m;                 // Защищает поля ниже
+    condition_variable done; // Сигнал владельцу о завершении помощников
+    int next = 0;            // Индекс следующего не розданного хода
+    int slaves = 0;          // Количество работающих помощников
+    Node_bounds bounds;      // Общие границы окна и лучший результат
+    atomic<bool> cutoff{ false }; // Найдено отсечение: остальные ходы узла можно не считать
+
+    // Отменён ли поиск в этой точке или в любой из внешних
+    bool aborted() const
+    {
+        for (const Split_point* sp = this; sp; sp = sp->parent)
+        {
+            if (sp->cutoff.load(memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+    // Помощник закончил работу в этой точке. После выхода из функции обращаться к объекту нельзя.
+    void leave()
+    {
+        lock_guard<mutex> lock(m);
+        --slaves;
+        done.notify_all();
+    }
+
+    // Владелец ждёт, пока все помощники закончат работу.
+    void wait_slaves()
+    {
+        unique_lock<mutex> lock(m);
+        done.wait(lock, [this]() { return slaves == 0; });
+    }
+};
+
+// Пул вспомогательных потоков для поиска с точками разделения.
+// Свободный поток ждёт, пока какой-нибудь поток не назначит ему точку разделения.
+class Split_pool
+{
+public:
+    explicit Split_pool(const int workers) : assigned(workers, nullptr), idle(workers, true), idle_count(workers)
+    {
+    }
+
+    // Есть ли свободные потоки (проверка без блокировки, может быть неточной)
+    bool has_idle() const
+    {
+        return idle_count.load(memory_order_relaxed) > 0;
+    }
+
+    // Назначает точке разделения свободные потоки, возвращает их количество
+    int recruit(Split_point& sp)
+    {
+        lock_guard<mutex> lock(m);
+        int count = 0;
+        for (size_t i = 0; i < idle.size() && !quit; ++i)
+        {
+            if (!idle[i])
+                continue;
+            idle[i] = false;
+            assigned[i] = &sp;
+            --idle_count;
+            ++count;
+        }
+        if (count)
+        {
+            lock_guard<mutex> sp_lock(sp.m);
+            sp.slaves += count;
+            work.notify_all();
+        }
+        return count;
+    }
+
+    // Ожидание работы потоком worker. Возвращает nullptr, когда пул завершает работу.
+    Split_point* wait_work(const int worker)
+    {
+        unique_lock<mutex> lock(m);
+        work.wait(lock, [this, worker]() { return quit || assigned[worker] != nullptr; });
+        return assigned[worker];
+    }
+
+    // Поток worker закончил работу в точке разделения и снова свободен
+    void finish_work(const int worker)
+    {
+        lock_guard<mutex> lock(m);
+        assigned[worker] = nullptr;
+        idle[worker] = true;
+        ++idle_count;
+    }
+
+    // Запуск пула перед поиском
+    void start()
+    {
+        lock_guard<mutex> lock(m);
+        quit = false;
+    }
+
+    // Остановка пула: ожидающие потоки выходят из wait_work
+    void shutdown()
+    {
+        lock_guard<mutex> lock(m);
+        quit = true;
+        work.notify_all();
+    }
+
+private:
+    mutex m;
+    condition_variable work;
+    vector<Split_point*> assigned;
+    vector<bool> idle;
+    atomic<int> idle_count;
+    bool quit = false;
+};
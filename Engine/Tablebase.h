@@ -0,0 +1,483 @@
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "../Models/Position.h"
+#include "Mapped_file.h"
+#include "Move_gen.h"
+
+// Наибольшее число фигур на доске, для которого можно построить базу
+const int TB_MAX_PIECES = 5;
+
+// Значение позиции в базе для стороны, которая ходит (один байт):
+// 0 - ничья, d > 0 - выигрыш за d полуходов, -(d + 1) - проигрыш за d полуходов (-1 - ходов нет).
+// Полуход - это ход одной стороны целиком, вместе со всей цепочкой ударов.
+// В байт помещаются расстояния не больше TB_MAX_DISTANCE; если набору фигур нужно больше, база не строится.
+const int TB_MAX_DISTANCE = 126;
+const int8_t TB_DRAW = 0;
+const int8_t TB_INVALID = -128; // Такой расстановки не бывает (фигуры на одной клетке, шашка на последней строке)
+
+inline bool tb_win(const int8_t value)
+{
+    return value > 0;
+}
+
+inline bool tb_loss(const int8_t value)
+{
+    return value < 0 && value != TB_INVALID;
+}
+
+// Количество полуходов до конца партии при правильной игре
+inline int tb_distance(const int8_t value)
+{
+    return value > 0 ? value : -value - 1;
+}
+
+// Класс Tablebase - эндшпильная база: точные результаты всех позиций, где на доске не больше pieces() фигур.
+// Позиции одного набора фигур (количество белых и чёрных шашек и дамок) нумеруются сочетаниями клеток
+// каждой группы фигур, значение хранится в одном байте для каждой стороны.
+// Файл базы отображается в память и используется без разбора.
+//
+// Формат файла: заголовок (File_header), count записей Table_record, затем данные таблиц:
+// size байт для хода белых и size байт для хода чёрных по смещению offset от начала файла.
+class Tablebase
+{
+public:
+    Tablebase() : tables(TABLE_SLOTS * 2, nullptr)
+    {
+    }
+
+    // Загрузка базы из файла, false - файла нет или формат не подходит
+    bool load(const string& path)
+    {
+        max_pieces = 0;
+        if (!file.open(path) || file.size() < sizeof(File_header))
+            return false;
+        File_header header;
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 || header.max_pieces > TB_MAX_PIECES ||
+            sizeof(header) + header.count * sizeof(Table_record) > file.size())
+            return false;
+        const Table_record* records = reinterpret_cast<const Table_record*>(file.data() + sizeof(header));
+        for (uint32_t i = 0; i < header.count; ++i)
+        {
+            const Table_record& r = records[i];
+            const Signature sig{ { r.men[0], r.men[1] }, { r.kings[0], r.kings[1] } };
+            if (r.offset + 2 * r.size > file.size() || table_size(sig) != r.size)
+                return false;
+            const int8_t* data = reinterpret_cast<const int8_t*>(file.data() + r.offset);
+            set_table(sig, data, data + r.size);
+        }
+        max_pieces = int(header.max_pieces);
+        return true;
+    }
+
+    bool loaded() const
+    {
+        return max_pieces > 0;
+    }
+
+    // Наибольшее число фигур в позициях базы
+    int pieces() const
+    {
+        return max_pieces;
+    }
+
+    // Значение позиции для стороны color, false - позиция не покрыта базой
+    bool probe(const Position& pos, const bool color, int8_t& value) const
+    {
+        if (!pos.pieces[color])
+        {
+            // Фигур не осталось - ходов нет.
+            value = -1;
+            return true;
+        }
+        if (!pos.pieces[!color] || bit_count(pos.occupied()) > max_pieces)
+            return false;
+        const Signature sig = signature(pos);
+        const int8_t* table = tables[slot(sig) * 2 + color];
+        if (!table)
+            return false;
+        value = table[index(pos, sig)];
+        return value != TB_INVALID;
+    }
+
+    // Ход по базе: при выигрыше - самый быстрый, при проигрыше - самый долгий, при ничьей - любой ничейный.
+    // Ход записывается цепочкой в chain, false - позиция не покрыта базой или ходов нет.
+    bool best_turn(Position pos, const bool color, vector<sq_move>& chain) const
+    {
+        int8_t root;
+        if (!probe(pos, color, root))
+            return false;
+        chain.clear();
+        int best = -1;
+        Move_gen::for_each_turn(pos, color, [&](const Position& next, const vector<sq_move>& turns) {
+            int8_t value;
+            if (!probe(next, !color, value))
+                return;
+            // Ценность хода для стороны color: чем больше, тем лучше
+            int rank;
+            if (tb_loss(value))
+                rank = 1000 - tb_distance(value);
+            else if (value == TB_DRAW)
+                rank = 500;
+            else
+                rank = tb_distance(value);
+            if (rank > best)
+            {
+                best = rank;
+                chain = turns;
+            }
+        });
+        return !chain.empty();
+    }
+
+    // Построение базы для всех позиций, где у каждой стороны есть фигуры, а всего фигур не больше max_pieces.
+    // Ход по-прежнему генерируется Move_gen, поэтому база соответствует правилам игры в этом проекте.
+    // log - поток для вывода хода построения (или nullptr).
+    static bool generate(const int pieces, const string& path, FILE* log)
+    {
+        if (pieces < 2 || pieces > TB_MAX_PIECES)
+            return false;
+        Tablebase tb;
+        tb.max_pieces = pieces;
+
+        // Наборы фигур: сначала с меньшим числом фигур (взятия ведут в них), затем с меньшим числом
+        // шашек (превращение в дамку ведёт в набор с меньшим числом шашек).
+        vector<Signature> sigs;
+        for (int wm = 0; wm <= pieces; ++wm)
+            for (int wk = 0; wm + wk <= pieces; ++wk)
+                for (int bm = 0; wm + wk + bm <= pieces; ++bm)
+                    for (int bk = 0; wm + wk + bm + bk <= pieces; ++bk)
+                    {
+                        if (wm + wk > 0 && bm + bk > 0)
+                            sigs.push_back(Signature{ { uint8_t(wm), uint8_t(bm) }, { uint8_t(wk), uint8_t(bk) } });
+                    }
+        stable_sort(sigs.begin(), sigs.end(), [](const Signature& a, const Signature& b) {
+            const int total_a = a.men[0] + a.men[1] + a.kings[0] + a.kings[1];
+            const int total_b = b.men[0] + b.men[1] + b.kings[0] + b.kings[1];
+            return total_a != total_b ? total_a < total_b : a.men[0] + a.men[1] < b.men[0] + b.men[1];
+        });
+
+        vector<vector<int8_t>> storage(sigs.size() * 2);
+        int max_distance = 0;
+        for (size_t s = 0; s < sigs.size(); ++s)
+        {
+            const Signature& sig = sigs[s];
+            const uint64_t size = table_size(sig);
+            storage[2 * s].assign(size, TB_DRAW);
+            storage[2 * s + 1].assign(size, TB_DRAW);
+            tb.set_table(sig, storage[2 * s].data(), storage[2 * s + 1].data());
+            const auto start = chrono::steady_clock::now();
+            const int distance = tb.solve(sig, storage[2 * s].data(), storage[2 * s + 1].data(), max_distance);
+            if (distance < 0)
+            {
+                if (log)
+                {
+                    fprintf(log, "%s  distance exceeds %d half-moves\n", name(sig).c_str(), TB_MAX_DISTANCE);
+                    fflush(log);
+                }
+                return false;
+            }
+            max_distance = max(max_distance, distance);
+            if (log)
+            {
+                uint64_t wins = 0, losses = 0, draws = 0;
+                for (int side = 0; side < 2; ++side)
+                {
+                    for (const int8_t value : storage[2 * s + side])
+                    {
+                        wins += tb_win(value);
+                        losses += tb_loss(value);
+                        draws += (value == TB_DRAW);
+                    }
+                }
+                fprintf(log, "%s  positions %10llu  wins %10llu  losses %10llu  draws %10llu  %.1f s\n",
+                        name(sig).c_str(), (unsigned long long)(wins + losses + draws), (unsigned long long)wins,
+                        (unsigned long long)losses, (unsigned long long)draws,
+                        chrono::duration<double>(chrono::steady_clock::now() - start).count());
+                fflush(log);
+            }
+        }
+
+        // Запись файла: заголовок, записи таблиц, данные
+        FILE* out = fopen(path.c_str(), "wb");
+        if (!out)
+            return false;
+        File_header header;
+        memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.max_pieces = uint32_t(pieces);
+        header.count = uint32_t(sigs.size());
+        bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+        uint64_t offset = sizeof(header) + sigs.size() * sizeof(Table_record);
+        for (size_t s = 0; s < sigs.size(); ++s)
+        {
+            Table_record r;
+            memset(&r, 0, sizeof(r));
+            memcpy(r.men, sigs[s].men, sizeof(r.men));
+            memcpy(r.kings, sigs[s].kings, sizeof(r.kings));
+            r.offset = offset;
+            r.size = storage[2 * s].size();
+            offset += 2 * r.size;
+            ok = ok && fwrite(&r, sizeof(r), 1, out) == 1;
+        }
+        for (const vector<int8_t>& table : storage)
+            ok = ok && fwrite(table.data(), 1, table.size(), out) == table.size();
+        return fclose(out) == 0 && ok;
+    }
+
+private:
+    // Набор фигур: количество шашек и дамок каждого цвета
+    struct Signature
+    {
+        uint8_t men[2];
+        uint8_t kings[2];
+    };
+
+    struct File_header
+    {
+        char magic[8];
+        uint32_t max_pieces;
+        uint32_t count; // Количество таблиц (наборов фигур)
+    };
+
+    struct Table_record
+    {
+        uint8_t men[2];
+        uint8_t kings[2];
+        uint32_t reserved;
+        uint64_t offset; // Смещение данных от начала файла
+        uint64_t size;   // Количество позиций для каждой стороны
+    };
+
+    static constexpr char MAGIC[8] = { 'C', 'K', 'T', 'B', '0', '0', '1', '\0' };
+    static const int TABLE_SLOTS = (TB_MAX_PIECES + 1) * (TB_MAX_PIECES + 1) * (TB_MAX_PIECES + 1) * (TB_MAX_PIECES + 1);
+
+    // Биномиальные коэффициенты C(n, k) для n <= 32
+    static uint64_t binom(const int n, const int k)
+    {
+        struct Table
+        {
+            uint64_t c[33][TB_MAX_PIECES + 1];
+            Table()
+            {
+                for (int n = 0; n <= 32; ++n)
+                {
+                    c[n][0] = 1;
+                    for (int k = 1; k <= TB_MAX_PIECES; ++k)
+                        c[n][k] = (n ? c[n - 1][k - 1] + c[n - 1][k] : 0);
+                }
+            }
+        };
+        static const Table t;
+        return t.c[n][k];
+    }
+
+    static int slot(const Signature& sig)
+    {
+        const int n = TB_MAX_PIECES + 1;
+        return ((sig.men[0] * n + sig.kings[0]) * n + sig.men[1]) * n + sig.kings[1];
+    }
+
+    static Signature signature(const Position& pos)
+    {
+        return Signature{ { uint8_t(bit_count(pos.men(0))), uint8_t(bit_count(pos.men(1))) },
+                          { uint8_t(bit_count(pos.kings(0))), uint8_t(bit_count(pos.kings(1))) } };
+    }
+
+    static string name(const Signature& sig)
+    {
+        return string(sig.men[0], 'w') + string(sig.kings[0], 'W') + "-" + string(sig.men[1], 'b') +
+               string(sig.kings[1], 'B');
+    }
+
+    // Группы фигур в порядке нумерации: белые шашки, белые дамки, чёрные шашки, чёрные дамки
+    static int group_count(const Signature& sig, const int group)
+    {
+        return group % 2 ? sig.kings[group / 2] : sig.men[group / 2];
+    }
+
+    static BB_T group_mask(const Position& pos, const int group)
+    {
+        return group % 2 ? pos.kings(group / 2) : pos.men(group / 2);
+    }
+
+    static uint64_t table_size(const Signature& sig)
+    {
+        uint64_t size = 1;
+        for (int group = 0; group < 4; ++group)
+            size *= binom(32, group_count(sig, group));
+        return size;
+    }
+
+    // Номер сочетания клеток маски среди всех сочетаний из bit_count(bb) клеток
+    static uint64_t rank(BB_T bb)
+    {
+        uint64_t res = 0;
+        for (int i = 1; bb; ++i)
+            res += binom(pop_lsb(bb), i);
+        return res;
+    }
+
+    // Сочетание из k клеток по его номеру
+    static BB_T unrank(uint64_t r, const int k)
+    {
+        BB_T bb = 0;
+        int sq = 32;
+        for (int i = k; i >= 1; --i)
+        {
+            do
+                --sq;
+            while (binom(sq, i) > r);
+            r -= binom(sq, i);
+            bb |= BB_T(1) << sq;
+        }
+        return bb;
+    }
+
+    static uint64_t index(const Position& pos, const Signature& sig)
+    {
+        uint64_t idx = 0;
+        for (int group = 0; group < 4; ++group)
+            idx = idx * binom(32, group_count(sig, group)) + rank(group_mask(pos, group));
+        return idx;
+    }
+
+    // Позиция по номеру, false - такой расстановки не бывает
+    static bool decode(const Signature& sig, uint64_t idx, Position& pos)
+    {
+        BB_T masks[4];
+        for (int group = 3; group >= 0; --group)
+        {
+            const uint64_t count = binom(32, group_count(sig, group));
+            masks[group] = unrank(idx % count, group_count(sig, group));
+            idx /= count;
+        }
+        // Белые шашки не стоят на верхней строке, чёрные - на нижней (там они уже стали бы дамками)
+        const BB_T top_row = 0x0000000F, bottom_row = 0xF0000000;
+        if ((masks[0] & top_row) || (masks[2] & bottom_row))
+            return false;
+        if (bit_count(masks[0] | masks[1] | masks[2] | masks[3]) !=
+            bit_count(masks[0]) + bit_count(masks[1]) + bit_count(masks[2]) + bit_count(masks[3]))
+            return false;
+        pos = Position();
+        // Тип фигуры в формате Board::mtx для каждой группы
+        const POS_T types[4] = { 1, 3, 2, 4 };
+        for (int group = 0; group < 4; ++group)
+        {
+            for (BB_T bb = masks[group]; bb;)
+                pos.set_cell(pop_lsb(bb), types[group]);
+        }
+        return true;
+    }
+
+    void set_table(const Signature& sig, const int8_t* white, const int8_t* black)
+    {
+        tables[slot(sig) * 2] = white;
+        tables[slot(sig) * 2 + 1] = black;
+    }
+
+    // Ретроградный анализ одного набора фигур. Переходы ведут либо в этот же набор, либо в уже решённые.
+    // На шаге k решаются позиции с выигрышем или проигрышем за k полуходов: выигрыш - если есть ход
+    // в проигрыш соперника за k - 1, проигрыш - если все ходы ведут в выигрыш соперника не дольше k - 1.
+    // Возвращает наибольшее найденное расстояние или -1, если позиции не решены за TB_MAX_DISTANCE полуходов.
+    int solve(const Signature& sig, int8_t* white, int8_t* black, const int solved_distance) const
+    {
+        int8_t* data[2] = { white, black };
+        const uint64_t size = table_size(sig);
+        vector<uint32_t> pending[2];
+        int max_distance = 0;
+        for (int side = 0; side < 2; ++side)
+        {
+            for (uint64_t idx = 0; idx < size; ++idx)
+            {
+                Position pos;
+                if (!decode(sig, idx, pos))
+                {
+                    data[side][idx] = TB_INVALID;
+                    continue;
+                }
+                Move_list list;
+                Move_gen::find_turns(pos, bool(side), list);
+                if (list.empty())
+                    data[side][idx] = -1; // Ходов нет - проигрыш
+                else
+                    pending[side].push_back(uint32_t(idx));
+            }
+        }
+
+        struct Decision
+        {
+            int side;
+            uint32_t idx;
+            int8_t value;
+        };
+        for (int k = 1;; ++k)
+        {
+            // Решения ещё возможны, а расстояние уже не помещается в байт
+            if (k > TB_MAX_DISTANCE)
+                return -1;
+            vector<Decision> decisions;
+            for (int side = 0; side < 2; ++side)
+            {
+                for (const uint32_t idx : pending[side])
+                {
+                    Position pos;
+                    decode(sig, idx, pos);
+                    int min_loss = 1 << 30, max_win = -1;
+                    bool all_win = true;
+                    Move_gen::for_each_turn(pos, bool(side), [&](const Position& next, const vector<sq_move>&) {
+                        int8_t value;
+                        if (!probe(next, !side, value) || !(tb_win(value) || tb_loss(value)))
+                        {
+                            all_win = false;
+                            return;
+                        }
+                        if (tb_loss(value))
+                        {
+                            all_win = false;
+                            min_loss = min(min_loss, tb_distance(value));
+                        }
+                        else
+                            max_win = max(max_win, tb_distance(value));
+                    });
+                    if (min_loss + 1 <= k)
+                        decisions.push_back({ side, idx, int8_t(min_loss + 1) });
+                    else if (all_win && max_win + 1 <= k)
+                        decisions.push_back({ side, idx, int8_t(-(max_win + 1) - 1) });
+                }
+            }
+            // Решения шага применяются разом, чтобы на шаге k использовались только результаты шагов до k.
+            for (const Decision& d : decisions)
+            {
+                data[d.side][d.idx] = d.value;
+                max_distance = max(max_distance, tb_distance(d.value));
+            }
+            if (!decisions.empty())
+            {
+                for (int side = 0; side < 2; ++side)
+                {
+                    pending[side].erase(remove_if(pending[side].begin(), pending[side].end(),
+                                                  [&](const uint32_t idx) { return data[side][idx] != TB_DRAW; }),
+                                        pending[side].end());
+                }
+            }
+            // Новые решения возможны, только пока не исчерпаны расстояния уже решённых наборов
+            // или на предыдущем шаге что-то решилось.
+            if ((decisions.empty() && k > solved_distance + 1) || (pending[0].empty() && pending[1].empty()))
+                break;
+        }
+        return max_distance;
+    }
+
+    Mapped_file file;
+    int max_pieces = 0;
+    // Таблицы по наборам фигур: [slot * 2 + цвет], nullptr - набора нет в базе
+    vector<const int8_t*> tables;
+};
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "../Models/Move.h"
+#include "../Models/Position.h"
 #include "../Models/Project_path.h"
 
 #ifdef __APPLE__
@@ -16,7 +17,25 @@
 
 using namespace std;
 
-// Класс Board управляет отрисовкой доски и фигур
+// Минимальный интервал между кадрами в миллисекундах (не больше 60 кадров в секунду)
+const Uint32 FRAME_MS = 16;
+// Период анимации индикатора "бот думает" в миллисекундах
+const Uint32 THINKING_FRAME_MS = 250;
+// Через сколько шагов истории сохраняется снимок доски (для быстрого восстановления любой позиции партии)
+const size_t HISTORY_SNAPSHOT_STEPS = 64;
+
+// Шаг истории ходов: перемещение фигуры (возможно, со взятием) и всё, что нужно для его отмены.
+struct History_step
+{
+    move_pos turn;       // Ход (координаты побитой фигуры - xb, yb)
+    POS_T piece;         // Фигура до хода (до превращения в дамку)
+    POS_T captured;      // Побитая фигура (0 - хода без взятия)
+    uint8_t beat_series; // Номер удара в серии ударов (0 - ход без взятия)
+};
+
+// Класс Board управляет отрисовкой доски и фигур.
+// Изменения доски и подсветки только помечают кадр устаревшим, а рисует его present:
+// сколько бы изменений ни произошло между вызовами present, кадр рисуется один раз.
 class Board
 {
 public:
@@ -66,7 +85,8 @@ public:
             return 1;
         }
 
-        // Загружаем текстуры фигур и интерфейса
+        // Загружаем текстуры фигур и интерфейса (включая экраны результата): при перерисовке
+        // используются только загруженные здесь текстуры, файлы больше не читаются.
         board = IMG_LoadTexture(ren, board_path.c_str());
         w_piece = IMG_LoadTexture(ren, piece_white_path.c_str());
         b_piece = IMG_LoadTexture(ren, piece_black_path.c_str());
@@ -74,8 +94,12 @@ public:
         b_queen = IMG_LoadTexture(ren, queen_black_path.c_str());
         back = IMG_LoadTexture(ren, back_path.c_str());
         replay = IMG_LoadTexture(ren, replay_path.c_str());
+        white_wins = IMG_LoadTexture(ren, white_path.c_str());
+        black_wins = IMG_LoadTexture(ren, black_path.c_str());
+        draw_res = IMG_LoadTexture(ren, draw_path.c_str());
 
-        if (!board || !w_piece || !b_piece || !w_queen || !b_queen || !back || !replay)
+        if (!board || !w_piece || !b_piece || !w_queen || !b_queen || !back || !replay || !white_wins || !black_wins ||
+            !draw_res)
         {
             print_exception("IMG_LoadTexture can't load main textures from " + textures_path);
             return 1;
@@ -86,7 +110,7 @@ public:
 
         // Создаем начальное состояние доски
         make_start_mtx();
-        rerender();
+        present();
         return 0;
     }
 
@@ -94,8 +118,7 @@ public:
     void redraw()
     {
         game_results = -1;
-        history_mtx.clear();
-        history_beat_series.clear();
+        thinking = false;
         make_start_mtx();
         clear_active();
         clear_highlight();
@@ -104,56 +127,27 @@ public:
     // Функция перемещения фигуры
     void move_piece(move_pos turn, const int beat_series = 0)
     {
-        // Если ход сопровождается побитием фигуры, удаляем побитую фигуру
-        if (turn.xb != -1)
-        {
-            mtx[turn.xb][turn.yb] = 0;
-        }
-        move_piece(turn.x, turn.y, turn.x2, turn.y2, beat_series);
-    }
-
-    // Перемещение фигуры на новые координаты
-    void move_piece(const POS_T i, const POS_T j, const POS_T i2, const POS_T j2, const int beat_series = 0)
-    {
-        if (mtx[i2][j2])
+        if (mtx[turn.x2][turn.y2])
         {
             throw runtime_error("final position is not empty, can't move");
         }
-        if (!mtx[i][j])
+        if (!mtx[turn.x][turn.y])
         {
             throw runtime_error("begin position is empty, can't move");
         }
 
-        // Если фигура достигла конца доски, превращаем её в дамку
-        if ((mtx[i][j] == 1 && i2 == 0) || (mtx[i][j] == 2 && i2 == 7))
-            mtx[i][j] += 2;
-
-        // Перемещаем фигуру
-        mtx[i2][j2] = mtx[i][j];
-
-        // Очищаем старую позицию
-        drop_piece(i, j);
-
-        // Добавляем ход в историю
-        add_history(beat_series);
+        // Добавляем ход в историю (до хода, чтобы запомнить фигуру и побитую фигуру)
+        const History_step step{ turn, mtx[turn.x][turn.y], (turn.xb != -1 ? mtx[turn.xb][turn.yb] : POS_T(0)),
+                                 uint8_t(beat_series) };
+        apply_step(mtx, step);
+        add_history(step);
+        dirty = true;
     }
 
-    // Функция удаления фигуры с доски
-    void drop_piece(const POS_T i, const POS_T j)
+    // Перемещение фигуры на новые координаты
+    void move_piece(const POS_T i, const POS_T j, const POS_T i2, const POS_T j2, const int beat_series = 0)
     {
-        mtx[i][j] = 0;
-        rerender();
-    }
-
-    // Функция превращения фигуры в дамку
-    void turn_into_queen(const POS_T i, const POS_T j)
-    {
-        if (mtx[i][j] == 0 || mtx[i][j] > 2)
-        {
-            throw runtime_error("can't turn into queen in this position");
-        }
-        mtx[i][j] += 2;
-        rerender();
+        move_piece(move_pos(i, j, i2, j2), beat_series);
     }
 
     // Функция получения текущего состояния доски
@@ -170,7 +164,7 @@ public:
             POS_T x = pos.first, y = pos.second;
             is_highlighted_[x][y] = 1;
         }
-        rerender();
+        dirty = true;
     }
 
     // Функция очистки подсветки
@@ -180,7 +174,7 @@ public:
         {
             is_highlighted_[i].assign(8, 0);
         }
-        rerender();
+        dirty = true;
     }
 
     // Функция подсветки активной клетки
@@ -188,7 +182,7 @@ public:
     {
         active_x = x;
         active_y = y;
-        rerender();
+        dirty = true;
     }
 
     // Функция очистки активной клетки
@@ -196,7 +190,7 @@ public:
     {
         active_x = -1;
         active_y = -1;
-        rerender();
+        dirty = true;
     }
 
     // Проверяет, подсвечена ли клетка
@@ -205,32 +199,86 @@ public:
         return is_highlighted_[x][y];
     }
 
-    // Функция отката хода
+    // Количество шагов в истории ходов (удар серии - отдельный шаг)
+    size_t history_size() const
+    {
+        return history.size();
+    }
+
+    // Функция отката хода: отменяет последний ход целиком (все удары серии)
     void rollback()
     {
-        auto beat_series = max(1, *(history_beat_series.rbegin()));
-        while (beat_series-- && history_mtx.size() > 1)
+        const size_t beat_series = (history.empty() ? 1 : max(1, int(history.back().beat_series)));
+        rollback_to(history.size() - min(beat_series, history.size()));
+    }
+
+    // Откат партии к доске после первых steps шагов. Шаги отменяются по одному, а если от ближайшего
+    // предыдущего снимка идти ближе, доска берётся из снимка и шаги после него выполняются заново.
+    void rollback_to(const size_t steps)
+    {
+        const size_t last = min(steps, history.size());
+        const size_t from_snapshot = last % HISTORY_SNAPSHOT_STEPS;
+        if (history.size() - last > from_snapshot)
+            mtx = history_board(last);
+        else
         {
-            history_mtx.pop_back();
-            history_beat_series.pop_back();
+            for (size_t i = history.size(); i > last; --i)
+                undo_step(mtx, history[i - 1]);
         }
-        mtx = *(history_mtx.rbegin());
+        history.erase(history.begin() + last, history.end());
+        // Снимки после отменённых шагов больше не нужны
+        snapshots.erase(snapshots.begin() + last / HISTORY_SNAPSHOT_STEPS + 1, snapshots.end());
         clear_highlight();
         clear_active();
     }
 
+    // Доска после первых steps шагов партии: берётся ближайший предыдущий снимок и шаги после него
+    // выполняются заново.
+    vector<vector<POS_T>> history_board(const size_t steps) const
+    {
+        const size_t last = min(steps, history.size());
+        vector<vector<POS_T>> res = snapshots[last / HISTORY_SNAPSHOT_STEPS].to_mtx();
+        for (size_t i = last / HISTORY_SNAPSHOT_STEPS * HISTORY_SNAPSHOT_STEPS; i < last; ++i)
+            apply_step(res, history[i]);
+        return res;
+    }
+
     // Функция показа результата игры
     void show_final(const int res)
     {
         game_results = res;
-        rerender();
+        dirty = true;
+    }
+
+    // Функция включения и выключения индикатора "бот думает"
+    void set_thinking(const bool value)
+    {
+        thinking = value;
+        dirty = true;
     }
 
     // Функция сброса размеров окна при изменении
     void reset_window_size()
     {
         SDL_GetRendererOutputSize(ren, &W, &H);
+        dirty = true;
+    }
+
+    // Функция вывода кадра: если состояние изменилось, перерисовывает доску, но не чаще раза за FRAME_MS.
+    // Вызывается циклами ожидания ввода и после каждого шага хода бота.
+    void present()
+    {
+        const Uint32 elapsed = SDL_GetTicks() - last_frame;
+        // Пока бот думает, индикатор анимируется: кадр устаревает каждые THINKING_FRAME_MS
+        if (thinking && elapsed >= THINKING_FRAME_MS)
+            dirty = true;
+        if (!dirty || !ren)
+            return;
+        if (elapsed < FRAME_MS)
+            SDL_Delay(FRAME_MS - elapsed);
         rerender();
+        last_frame = SDL_GetTicks();
+        dirty = false;
     }
 
     // Освобождение памяти и завершение программы
@@ -243,6 +291,9 @@ public:
         SDL_DestroyTexture(b_queen);
         SDL_DestroyTexture(back);
         SDL_DestroyTexture(replay);
+        SDL_DestroyTexture(white_wins);
+        SDL_DestroyTexture(black_wins);
+        SDL_DestroyTexture(draw_res);
         SDL_DestroyRenderer(ren);
         SDL_DestroyWindow(win);
         SDL_Quit();
@@ -255,11 +306,37 @@ public:
     }
 
 private:
-    // Добавляет текущее состояние доски в историю ходов
-    void add_history(const int beat_series = 0)
+    // Добавляет выполненный шаг в историю ходов, каждые HISTORY_SNAPSHOT_STEPS шагов - снимок доски
+    void add_history(const History_step& step)
+    {
+        history.push_back(step);
+        if (history.size() % HISTORY_SNAPSHOT_STEPS == 0)
+            snapshots.push_back(Position::from_mtx(mtx));
+    }
+
+    // Выполняет шаг истории на доске m
+    static void apply_step(vector<vector<POS_T>>& m, const History_step& step)
+    {
+        const move_pos& turn = step.turn;
+        // Если ход сопровождается побитием фигуры, удаляем побитую фигуру
+        if (turn.xb != -1)
+            m[turn.xb][turn.yb] = 0;
+        // Если фигура достигла конца доски, превращаем её в дамку
+        POS_T piece = step.piece;
+        if ((piece == 1 && turn.x2 == 0) || (piece == 2 && turn.x2 == 7))
+            piece += 2;
+        m[turn.x2][turn.y2] = piece;
+        m[turn.x][turn.y] = 0;
+    }
+
+    // Отменяет шаг истории на доске m
+    static void undo_step(vector<vector<POS_T>>& m, const History_step& step)
     {
-        history_mtx.push_back(mtx);
-        history_beat_series.push_back(beat_series);
+        const move_pos& turn = step.turn;
+        m[turn.x2][turn.y2] = 0;
+        m[turn.x][turn.y] = step.piece;
+        if (turn.xb != -1)
+            m[turn.xb][turn.yb] = step.captured;
     }
 
     // Создает начальное состояние доски с расстановкой фигур
@@ -276,7 +353,10 @@ private:
                     mtx[i][j] = 1;
             }
         }
-        add_history(); // Добавляем в историю
+        // История начинается заново, первый снимок - начальная позиция
+        history.clear();
+        snapshots.assign(1, Position::from_mtx(mtx));
+        dirty = true;
     }
 
     // Перерисовывает доску и фигуры
@@ -346,32 +426,39 @@ private:
         SDL_Rect replay_rect{ W * 109 / 120, H / 40, W / 15, H / 15 };
         SDL_RenderCopy(ren, replay, NULL, &replay_rect);
 
+        // Индикатор "бот думает": три точки между кнопками, по очереди светится одна из них
+        if (thinking)
+        {
+            const int lit = int(SDL_GetTicks() / THINKING_FRAME_MS % 3);
+            for (int i = 0; i < 3; ++i)
+            {
+                if (i == lit)
+                    SDL_SetRenderDrawColor(ren, 255, 200, 0, 0);
+                else
+                    SDL_SetRenderDrawColor(ren, 120, 120, 120, 0);
+                SDL_Rect dot{ W * (45 + 4 * i) / 100, H / 25, W / 50, H / 50 };
+                SDL_RenderFillRect(ren, &dot);
+            }
+        }
+
         // Отображение результата игры
         if (game_results != -1)
         {
-            string result_path = draw_path;
+            SDL_Texture* result_texture = draw_res;
             if (game_results == 1)
-                result_path = white_path; // Победа белых
+                result_texture = white_wins; // Победа белых
             else if (game_results == 2)
-                result_path = black_path; // Победа черных
+                result_texture = black_wins; // Победа черных
 
-            SDL_Texture* result_texture = IMG_LoadTexture(ren, result_path.c_str());
-            if (result_texture == nullptr)
-            {
-                print_exception("IMG_LoadTexture can't load game result picture from " + result_path);
-                return;
-            }
             SDL_Rect res_rect{ W / 5, H * 3 / 10, W * 3 / 5, H * 2 / 5 };
             SDL_RenderCopy(ren, result_texture, NULL, &res_rect);
-            SDL_DestroyTexture(result_texture);
         }
 
         SDL_RenderPresent(ren);
 
-        // Нужно для macOS
-        SDL_Delay(10);
-        SDL_Event windowEvent;
-        SDL_PollEvent(&windowEvent);
+        // Нужно для macOS: окно обновляется только при обработке очереди событий.
+        // События из очереди не забираются, их разбирает Hand.
+        SDL_PumpEvents();
     }
 
     // Функция записи ошибки в лог-файл
@@ -386,9 +473,6 @@ private:
       int W = 0; // Ширина окна
       int H = 0; // Высота окна
 
-      // История состояний доски
-      vector<vector<vector<POS_T>>> history_mtx;
-
   private:
       SDL_Window* win = nullptr; // Окно SDL
       SDL_Renderer* ren = nullptr; // Рендерер SDL
@@ -401,6 +485,9 @@ private:
       SDL_Texture* b_queen = nullptr;
       SDL_Texture* back = nullptr;
       SDL_Texture* replay = nullptr;
+      SDL_Texture* white_wins = nullptr; // Экраны результата игры
+      SDL_Texture* black_wins = nullptr;
+      SDL_Texture* draw_res = nullptr;
 
       // Пути к файлам текстур
       const string textures_path = project_path + "Textures/";
@@ -415,6 +502,14 @@ private:
       const string back_path = textures_path + "back.png";
       const string replay_path = textures_path + "replay.png";
 
+      // Идёт поиск хода бота (показывается индикатор)
+      bool thinking = false;
+
+      // Кадр устарел и должен быть перерисован
+      bool dirty = true;
+      // Время вывода последнего кадра (SDL_GetTicks)
+      Uint32 last_frame = 0;
+
       // Координаты активной клетки
       int active_x = -1, active_y = -1;
 
@@ -427,6 +522,8 @@ private:
       // Игровое поле (1 - белые, 2 - черные, 3 - белая дамка, 4 - черная дамка)
       vector<vector<POS_T>> mtx = vector<vector<POS_T>>(8, vector<POS_T>(8, 0));
 
-      // История серий ударов
-      vector<int> history_beat_series;
+      // История ходов партии (по шагу на каждый удар серии)
+      vector<History_step> history;
+      // Снимки доски после каждых HISTORY_SNAPSHOT_STEPS шагов истории (нулевой - начальная позиция)
+      vector<Position> snapshots;
 };
@@ -1,12 +1,13 @@
 #pragma once
 #include <chrono>
+#include <ctime>
 #include <thread>
 
+#include "../Engine/Logic.h"
 #include "../Models/Project_path.h"
 #include "Board.h"
 #include "Config.h"
 #include "Hand.h"
-#include "Logic.h"
 
 class Game
 {
@@ -15,7 +16,7 @@ class Game
     Game() 
         : board(config("WindowSize", "Width"), config("WindowSize", "Hight")), 
           hand(&board), 
-          logic(&board, &config)
+          logic(make_unique<Logic>(engine_settings()))
     {
         // Очищаем лог-файл при старте игры
         ofstream fout(project_path + "log.txt", ios_base::trunc);
@@ -29,8 +30,9 @@ class Game
 
         if (is_replay)
         {
-            logic = Logic(&board, &config); // Пересоздаём объект логики
             config.reload(); // Перезагружаем настройки
+            logic.reset(); // Останавливаем фоновые поиски и удаляем старый объект логики
+            logic = make_unique<Logic>(engine_settings()); // Пересоздаём объект логики
             board.redraw(); // Перерисовываем игровое поле
         }
         else
@@ -47,13 +49,13 @@ class Game
         while (++turn_num < Max_turns)
         {
             beat_series = 0;
-            logic.find_turns(turn_num % 2); // Поиск возможных ходов
+            logic->find_turns(board.get_board(), turn_num % 2); // Поиск возможных ходов
 
-            if (logic.turns.empty()) // Если ходов нет, игра завершается
+            if (logic->turns.empty()) // Если ходов нет, игра завершается
                 break;
 
             // Определяем уровень сложности бота
-            logic.Max_depth = config("Bot", string((turn_num % 2) ? "Black" : "White") + string("BotLevel"));
+            logic->Max_depth = config("Bot", string((turn_num % 2) ? "Black" : "White") + string("BotLevel"));
 
             if (!config("Bot", string("Is") + string((turn_num % 2) ? "Black" : "White") + string("Bot")))
             {
@@ -71,8 +73,9 @@ class Game
                 }
                 else if (resp == Response::BACK) // Игрок хочет отменить ход
                 {
+                    logic->stop_ponder(); // Предсказанный ответ игрока уже не понадобится
                     if (config("Bot", string("Is") + string((1 - turn_num % 2) ? "Black" : "White") + string("Bot")) &&
-                        !beat_series && board.history_mtx.size() > 2)
+                        !beat_series && board.history_size() > 1)
                     {
                         board.rollback();
                         --turn_num;
@@ -86,7 +89,31 @@ class Game
                 }
             }
             else
-                bot_turn(turn_num % 2); // Если ход делает бот
+            {
+                auto resp = bot_turn(turn_num % 2); // Если ход делает бот
+                if (resp == Response::QUIT) // Игрок вышел, пока бот думал
+                {
+                    is_quit = true;
+                    break;
+                }
+                else if (resp == Response::REPLAY)
+                {
+                    is_replay = true;
+                    break;
+                }
+                else if (resp == Response::BACK)
+                {
+                    // Отменяем ход игрока, на который бот искал ответ: снова ходит игрок.
+                    board.rollback();
+                    turn_num -= 2;
+                    continue;
+                }
+
+                // Если следующим ходит игрок, бот ищет ответ на его предсказанный ход, пока игрок думает.
+                if (config("Bot", "Ponder") &&
+                    !config("Bot", string("Is") + string((1 - turn_num % 2) ? "Black" : "White") + string("Bot")))
+                    logic->start_ponder(board.get_board(), 1 - turn_num % 2);
+            }
         }
 
         // Записываем время игры в лог
@@ -126,17 +153,58 @@ class Game
     }
 
   private:
-    // Функция, выполняющая ход бота
-    void bot_turn(const bool color)
+    // Настройки движка из раздела "Bot" файла settings.json
+    Engine_settings engine_settings()
+    {
+        Engine_settings settings;
+        // Если в настройках бота не включён режим "NoRandom", используем текущее время в качестве seed.
+        // Иначе seed равен 0 (для воспроизводимости).
+        settings.seed = (!(config("Bot", "NoRandom")) ? unsigned(time(0)) : 0);
+        settings.scoring_mode = config("Bot", "BotScoringType");
+        settings.optimization = config("Bot", "Optimization");
+        settings.hash_mb = config("Bot", "HashMB");
+        settings.move_time_ms = config("Bot", "MoveTimeMS");
+        settings.threads = config("Bot", "Threads");
+        settings.parallel_mode = config("Bot", "ParallelMode");
+        settings.quiescence = config("Bot", "Quiescence");
+        const string tablebase = config("Bot", "Tablebase");
+        settings.tablebase_path = (tablebase.empty() ? "" : project_path + tablebase);
+        const string book = config("Bot", "OpeningBook");
+        settings.book_path = (book.empty() ? "" : project_path + book);
+        return settings;
+    }
+
+    // Функция, выполняющая ход бота. Поиск идёт в фоновом потоке, а окно продолжает обрабатывать события
+    // и показывает индикатор "бот думает". Выход, перезапуск и отмена хода (если предыдущий ход делал игрок)
+    // прерывают поиск, тогда функция возвращает соответствующий ответ, иначе - Response::OK.
+    Response bot_turn(const bool color)
     {
         auto start = chrono::steady_clock::now();
 
-        auto delay_ms = config("Bot", "BotDelayMS");
+        const Uint32 delay_ms = config("Bot", "BotDelayMS");
+        const bool can_back = !config("Bot", string("Is") + string(color ? "White" : "Black") + string("Bot"));
 
-        // Создаем поток для задержки перед ходом
-        thread th(SDL_Delay, delay_ms);
-        auto turns = logic.find_best_turns(color);
-        th.join();
+        // Ход показывается не раньше, чем через delay_ms после начала поиска
+        const Uint32 delay_end = SDL_GetTicks() + delay_ms;
+        board.set_thinking(true);
+        logic->start_search(board.get_board(), color, &Hand::wake);
+        while (!logic->search_finished() || SDL_GetTicks() < delay_end)
+        {
+            // Поиск закончится событием Hand::wake, а конец задержки наступит не позже, чем через её остаток.
+            int timeout = IDLE_WAIT_MS;
+            const Uint32 now = SDL_GetTicks();
+            if (logic->search_finished() && now < delay_end)
+                timeout = min(timeout, int(delay_end - now));
+            auto resp = get<0>(hand.next_event(timeout));
+            if (resp == Response::QUIT || resp == Response::REPLAY || (resp == Response::BACK && can_back))
+            {
+                logic->cancel_search();
+                board.set_thinking(false);
+                return resp;
+            }
+        }
+        board.set_thinking(false);
+        auto turns = logic->take_search_result();
         bool is_first = true;
 
         // Выполняем все ходы
@@ -144,17 +212,26 @@ class Game
         {
             if (!is_first)
             {
-                SDL_Delay(delay_ms);
+                // Пауза между ударами цепочки: события окна продолжают обрабатываться
+                const Uint32 step_end = SDL_GetTicks() + delay_ms;
+                for (Uint32 now = SDL_GetTicks(); now < step_end; now = SDL_GetTicks())
+                {
+                    auto resp = get<0>(hand.next_event(int(step_end - now)));
+                    if (resp == Response::QUIT || resp == Response::REPLAY)
+                        return resp;
+                }
             }
             is_first = false;
             beat_series += (turn.xb != -1);
             board.move_piece(turn, beat_series);
+            board.present(); // Каждый удар цепочки показывается отдельным кадром
         }
 
         auto end = chrono::steady_clock::now();
         ofstream fout(project_path + "log.txt", ios_base::app);
         fout << "Bot turn time: " << (int)chrono::duration<double, milli>(end - start).count() << " millisec\n";
         fout.close();
+        return Response::OK;
     }
 
     // Функция, обрабатывающая ход игрока
@@ -162,7 +239,7 @@ class Game
     {
         // Выделяем доступные ходы на доске
         vector<pair<POS_T, POS_T>> cells;
-        for (auto turn : logic.turns)
+        for (auto turn : logic->turns)
         {
             cells.emplace_back(turn.x, turn.y);
         }
@@ -184,7 +261,7 @@ class Game
 
             // Проверяем, выбрана ли корректная клетка
             bool is_correct = false;
-            for (auto turn : logic.turns)
+            for (auto turn : logic->turns)
             {
                 if (turn.x == cell.first && turn.y == cell.second)
                 {
@@ -216,7 +293,7 @@ class Game
     Config config;  // Конфигурация игры
     Board board;    // Игровое поле
     Hand hand;      // Взаимодействие с игроком
-    Logic logic;    // Логика игры
+    unique_ptr<Logic> logic; // Логика игры (объект с фоновыми потоками не перемещается)
     int beat_series; // Количество последовательных ударов
     bool is_replay = false; // Флаг для переигровки
 };
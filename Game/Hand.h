@@ -5,7 +5,12 @@
 #include "../Models/Response.h"
 #include "Board.h"
 
-// Класс Hand отвечает за обработку действий игрока (клики, выход, перезапуск)
+// Сколько миллисекунд ожидание ввода спит без событий, прежде чем проверить, не нужно ли вывести кадр
+const int IDLE_WAIT_MS = 250;
+
+// Класс Hand отвечает за обработку действий игрока (клики, выход, перезапуск).
+// Ввод ожидается в SDL_WaitEventTimeout: пока событий нет, поток спит, а не опрашивает очередь.
+// Фоновые потоки будят ожидание событием wake (например, когда бот нашёл ход).
 class Hand
 {
 public:
@@ -17,104 +22,86 @@ public:
     // Функция определяет, на какую клетку кликнул игрок, и возвращает ответ (Response)
     tuple<Response, POS_T, POS_T> get_cell() const
     {
-        SDL_Event windowEvent;
-        Response resp = Response::OK;
-        int x = -1, y = -1;
-        int xc = -1, yc = -1;
-
         while (true) // Ожидаем действий игрока
         {
-            if (SDL_PollEvent(&windowEvent)) // Проверяем события в окне
-            {
-                switch (windowEvent.type)
-                {
-                case SDL_QUIT: // Игрок закрыл окно
-                    resp = Response::QUIT;
-                    break;
-
-                case SDL_MOUSEBUTTONDOWN: // Игрок кликнул мышкой
-                    x = windowEvent.motion.x; // Координата X клика
-                    y = windowEvent.motion.y; // Координата Y клика
-
-                    // Определяем клетку на игровом поле
-                    xc = int(y / (board->H / 10) - 1);
-                    yc = int(x / (board->W / 10) - 1);
-
-                    if (xc == -1 && yc == -1 && board->history_mtx.size() > 1)
-                    {
-                        resp = Response::BACK; // Игрок нажал "Назад"
-                    }
-                    else if (xc == -1 && yc == 8)
-                    {
-                        resp = Response::REPLAY; // Игрок нажал "Перезапуск"
-                    }
-                    else if (xc >= 0 && xc < 8 && yc >= 0 && yc < 8)
-                    {
-                        resp = Response::CELL; // Игрок выбрал клетку на доске
-                    }
-                    else
-                    {
-                        xc = -1;
-                        yc = -1;
-                    }
-                    break;
-
-                case SDL_WINDOWEVENT: // Обработка событий окна
-                    if (windowEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
-                    {
-                        board->reset_window_size(); // Обновляем размер окна при изменении
-                        break;
-                    }
-                }
-
-                if (resp != Response::OK) // Если событие произошло, выходим из цикла
-                    break;
-            }
+            auto resp = next_event(IDLE_WAIT_MS);
+            // Событие не требует ответа (или это сообщение фонового потока, которого здесь не ждут)
+            if (get<0>(resp) != Response::OK && get<0>(resp) != Response::WAKE)
+                return resp; // Возвращаем тип события и координаты клетки
         }
-        return { resp, xc, yc }; // Возвращаем тип события и координаты клетки
     }
 
     // Функция ожидания действий игрока (например, выход или перезапуск)
     Response wait() const
     {
-        SDL_Event windowEvent;
-        Response resp = Response::OK;
-
         while (true) // Ожидаем события
         {
-            if (SDL_PollEvent(&windowEvent))
-            {
-                switch (windowEvent.type)
-                {
-                case SDL_QUIT: // Игрок закрыл окно
-                    resp = Response::QUIT;
-                    break;
-
-                case SDL_WINDOWEVENT_SIZE_CHANGED: // Игрок изменил размер окна
-                    board->reset_window_size();
-                    break;
+            const Response resp = get<0>(next_event(IDLE_WAIT_MS));
+            if (resp == Response::QUIT || resp == Response::REPLAY)
+                return resp; // Возвращаем тип действия
+        }
+    }
 
-                case SDL_MOUSEBUTTONDOWN: { // Игрок кликнул мышкой
-                    int x = windowEvent.motion.x;
-                    int y = windowEvent.motion.y;
+    // Единый разбор событий: выводит накопившиеся изменения доски и ждёт событие не дольше timeout_ms.
+    // Возвращает тип события и клетку (для Response::CELL). Response::OK - событие не требует ответа
+    // или время ожидания истекло.
+    tuple<Response, POS_T, POS_T> next_event(const int timeout_ms) const
+    {
+        board->present();
+        SDL_Event windowEvent;
+        if (!SDL_WaitEventTimeout(&windowEvent, timeout_ms))
+            return { Response::OK, -1, -1 };
 
-                    // Определяем, кликнул ли он в область "Перезапуск"
-                    int xc = int(y / (board->H / 10) - 1);
-                    int yc = int(x / (board->W / 10) - 1);
+        if (windowEvent.type == wake_event_type()) // Сообщение фонового потока
+            return { Response::WAKE, -1, -1 };
 
-                    if (xc == -1 && yc == 8)
-                        resp = Response::REPLAY; // Игрок выбрал "Перезапуск"
-                }
-                                        break;
-                }
+        switch (windowEvent.type)
+        {
+        case SDL_QUIT: // Игрок закрыл окно
+            return { Response::QUIT, -1, -1 };
+
+        case SDL_MOUSEBUTTONDOWN: { // Игрок кликнул мышкой
+            const int x = windowEvent.motion.x; // Координата X клика
+            const int y = windowEvent.motion.y; // Координата Y клика
+
+            // Определяем клетку на игровом поле
+            const POS_T xc = POS_T(y / (board->H / 10) - 1);
+            const POS_T yc = POS_T(x / (board->W / 10) - 1);
+
+            if (xc == -1 && yc == -1 && board->history_size() > 0)
+                return { Response::BACK, -1, -1 }; // Игрок нажал "Назад"
+            if (xc == -1 && yc == 8)
+                return { Response::REPLAY, -1, -1 }; // Игрок нажал "Перезапуск"
+            if (xc >= 0 && xc < 8 && yc >= 0 && yc < 8)
+                return { Response::CELL, xc, yc }; // Игрок выбрал клетку на доске
+            break;
+        }
 
-                if (resp != Response::OK) // Если действие выполнено, выходим из цикла
-                    break;
-            }
+        case SDL_WINDOWEVENT: // Обработка событий окна
+            // Окно изменило размер или было перекрыто: кадр нужно нарисовать заново
+            if (windowEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED ||
+                windowEvent.window.event == SDL_WINDOWEVENT_EXPOSED)
+                board->reset_window_size();
+            break;
         }
-        return resp; // Возвращаем тип действия
+        return { Response::OK, -1, -1 };
+    }
+
+    // Будит поток, ожидающий ввода (next_event вернёт Response::WAKE). Можно вызывать из любого потока.
+    static void wake()
+    {
+        SDL_Event event{};
+        event.type = wake_event_type();
+        SDL_PushEvent(&event);
     }
 
 private:
+    // Тип пользовательского события SDL для wake (регистрируется один раз)
+    static Uint32 wake_event_type()
+    {
+        static const Uint32 type = SDL_RegisterEvents(1);
+        return type;
+    }
+
     Board* board; // Указатель на игровое поле
 };
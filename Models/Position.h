@@ -0,0 +1,354 @@
+#pragma once
+#include <stdint.h>
+#include <bitset>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "Move.h"
+
+typedef uint32_t BB_T; // Битовая маска игровых клеток (по одному биту на каждую из 32 тёмных клеток)
+
+// Нумерация игровых клеток: клетка (x, y) с (x + y) % 2 == 1 получает индекс x * 4 + y / 2.
+// Таким образом, каждой строке доски соответствуют 4 последовательных бита.
+
+// Индекс клетки по координатам (клетка должна быть игровой)
+inline int sq_index(const POS_T x, const POS_T y)
+{
+    return x * 4 + y / 2;
+}
+
+// Строка клетки по её индексу
+inline POS_T sq_x(const int sq)
+{
+    return POS_T(sq / 4);
+}
+
+// Столбец клетки по её индексу
+inline POS_T sq_y(const int sq)
+{
+    return POS_T(2 * (sq % 4) + ((sq / 4) % 2 == 0));
+}
+
+// Количество установленных бит в маске
+inline int bit_count(const BB_T bb)
+{
+    return int(bitset<32>(bb).count());
+}
+
+// Индекс младшего установленного бита (маска не должна быть пустой)
+inline int lsb_index(const BB_T bb)
+{
+    // Последовательность де Брёйна для поиска младшего бита без встроенных функций компилятора
+    static const int debruijn_idx[32] = { 0,  1,  28, 2,  29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4,  8,
+                                          31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6,  11, 5,  10, 9 };
+    return debruijn_idx[((bb & (0u - bb)) * 0x077CB531u) >> 27];
+}
+
+// Индекс старшего установленного бита (маска не должна быть пустой)
+inline int msb_index(BB_T bb)
+{
+    // Заполняем единицами все биты ниже старшего, после чего старший бит однозначно определяется таблицей
+    static const int debruijn_idx[32] = { 0,  9,  1,  10, 13, 21, 2,  29, 11, 14, 16, 18, 22, 25, 3, 30,
+                                          8,  12, 20, 28, 15, 17, 24, 7,  19, 27, 23, 6,  26, 5,  4, 31 };
+    bb |= bb >> 1;
+    bb |= bb >> 2;
+    bb |= bb >> 4;
+    bb |= bb >> 8;
+    bb |= bb >> 16;
+    return debruijn_idx[(bb * 0x07C4ACDDu) >> 27];
+}
+
+// Извлекает младший установленный бит из маски и возвращает его индекс
+inline int pop_lsb(BB_T& bb)
+{
+    const int sq = lsb_index(bb);
+    bb &= bb - 1;
+    return sq;
+}
+
+// Компактный ход в индексах клеток (используется внутри поиска вместо move_pos)
+struct sq_move
+{
+    int8_t from = -1, to = -1; // Откуда и куда перемещается фигура
+    int8_t cap = -1;           // Клетка побитой фигуры (-1, если удара нет)
+
+    sq_move() = default;
+    sq_move(const int from, const int to, const int cap = -1) : from(int8_t(from)), to(int8_t(to)), cap(int8_t(cap))
+    {
+    }
+
+    // Преобразование в ход с координатами доски
+    move_pos to_move_pos() const
+    {
+        if (cap == -1)
+            return move_pos(sq_x(from), sq_y(from), sq_x(to), sq_y(to));
+        return move_pos(sq_x(from), sq_y(from), sq_x(to), sq_y(to), sq_x(cap), sq_y(cap));
+    }
+
+    bool operator==(const sq_move& other) const
+    {
+        return from == other.from && to == other.to && cap == other.cap;
+    }
+
+    bool operator!=(const sq_move& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// Ключи Зобриста для хеширования позиций.
+// piece[type - 1][sq] - фигура типа type (в формате Board::mtx) на клетке sq,
+// side - сторона, которая ходит, chain - клетка фигуры, продолжающей цепочку ударов.
+struct Zobrist
+{
+    uint64_t piece[4][32];
+    uint64_t side[2];
+    uint64_t chain[32];
+
+    Zobrist()
+    {
+        // Фиксированный seed, чтобы ключи совпадали между запусками
+        mt19937_64 rand_eng(20250617);
+        for (auto& keys : piece)
+            for (auto& key : keys)
+                key = rand_eng();
+        for (auto& key : side)
+            key = rand_eng();
+        for (auto& key : chain)
+            key = rand_eng();
+    }
+};
+
+inline const Zobrist& zobrist()
+{
+    static const Zobrist z;
+    return z;
+}
+
+// Продвижение простой шашки цвета color на клетке sq: на сколько строк она ушла от своего края доски
+inline int row_advance(const bool color, const int sq)
+{
+    return color ? sq_x(sq) : 7 - sq_x(sq);
+}
+
+// Счётчики для оценки позиции, которые обновляются вместе с ходами (индекс - цвет)
+struct Material
+{
+    int8_t men[2] = { 0, 0 };     // Количество простых шашек
+    int8_t kings[2] = { 0, 0 };   // Количество дамок
+    int16_t advance[2] = { 0, 0 }; // Суммарное продвижение простых шашек (row_advance)
+};
+
+// Информация для отмены хода, сохраняемая в Position::make
+struct Undo_info
+{
+    bool cap_queen = false; // Побитая фигура была дамкой
+    bool promoted = false;  // Ход превратил шашку в дамку
+    uint64_t prev_key = 0;  // Ключ позиции до хода
+    Material prev_material; // Счётчики до хода
+};
+
+// Компактное представление позиции на доске в виде битовых масок.
+// pieces[0] - все белые фигуры, pieces[1] - все чёрные фигуры, queens - все дамки (любого цвета).
+struct Position
+{
+    BB_T pieces[2] = { 0, 0 };
+    BB_T queens = 0;
+    uint64_t key = 0; // Ключ Зобриста расстановки фигур, обновляется инкрементально
+    Material material; // Счётчики фигур для оценки, обновляются инкрементально
+
+    // Занятые клетки
+    BB_T occupied() const
+    {
+        return pieces[0] | pieces[1];
+    }
+
+    // Простые шашки заданного цвета
+    BB_T men(const bool color) const
+    {
+        return pieces[color] & ~queens;
+    }
+
+    // Дамки заданного цвета
+    BB_T kings(const bool color) const
+    {
+        return pieces[color] & queens;
+    }
+
+    // Значение клетки в формате Board::mtx (0 - пусто, 1 - белая, 2 - чёрная, 3 - белая дамка, 4 - чёрная дамка)
+    POS_T cell(const int sq) const
+    {
+        const BB_T bit = BB_T(1) << sq;
+        if (!(occupied() & bit))
+            return 0;
+        return POS_T(((pieces[1] & bit) ? 2 : 1) + ((queens & bit) ? 2 : 0));
+    }
+
+    // То же самое, но по координатам клетки (для светлых клеток всегда 0)
+    POS_T operator()(const POS_T x, const POS_T y) const
+    {
+        if ((x + y) % 2 == 0)
+            return 0;
+        return cell(sq_index(x, y));
+    }
+
+    // Ставит на клетку фигуру в формате Board::mtx (0 очищает клетку)
+    void set_cell(const int sq, const POS_T type)
+    {
+        const BB_T bit = BB_T(1) << sq;
+        const POS_T old = cell(sq);
+        if (old)
+        {
+            key ^= zobrist().piece[old - 1][sq];
+            count(sq, old, -1);
+        }
+        if (type)
+        {
+            key ^= zobrist().piece[type - 1][sq];
+            count(sq, type, 1);
+        }
+        pieces[0] &= ~bit;
+        pieces[1] &= ~bit;
+        queens &= ~bit;
+        if (!type)
+            return;
+        pieces[type % 2 == 0] |= bit;
+        if (type > 2)
+            queens |= bit;
+    }
+
+    // Выполняет ход на месте, сохраняя в undo всё необходимое для отмены.
+    // Если в ходе происходит взятие фигуры, она удаляется; пешка на последней горизонтали становится дамкой.
+    void make(const sq_move turn, Undo_info& undo)
+    {
+        const BB_T from = BB_T(1) << turn.from, to = BB_T(1) << turn.to;
+        const bool color = (pieces[1] & from) != 0;
+        const Zobrist& z = zobrist();
+        undo.cap_queen = false;
+        undo.promoted = false;
+        undo.prev_key = key;
+        undo.prev_material = material;
+        if (turn.cap != -1)
+        {
+            const BB_T cap = BB_T(1) << turn.cap;
+            undo.cap_queen = (queens & cap) != 0;
+            key ^= z.piece[!color + 2 * undo.cap_queen][turn.cap];
+            pieces[!color] &= ~cap;
+            queens &= ~cap;
+            if (undo.cap_queen)
+                --material.kings[!color];
+            else
+            {
+                --material.men[!color];
+                material.advance[!color] -= int16_t(row_advance(!color, turn.cap));
+            }
+        }
+        const bool was_queen = (queens & from) != 0;
+        pieces[color] ^= from | to;
+        if (was_queen)
+            queens ^= from | to;
+        else if (sq_x(turn.to) == (color ? 7 : 0))
+        {
+            queens |= to;
+            undo.promoted = true;
+            --material.men[color];
+            ++material.kings[color];
+            material.advance[color] -= int16_t(row_advance(color, turn.from));
+        }
+        else
+            material.advance[color] += int16_t(row_advance(color, turn.to) - row_advance(color, turn.from));
+        key ^= z.piece[color + 2 * was_queen][turn.from] ^ z.piece[color + 2 * (was_queen || undo.promoted)][turn.to];
+    }
+
+    // Отменяет ход, ранее выполненный через make с тем же undo.
+    void unmake(const sq_move turn, const Undo_info& undo)
+    {
+        const BB_T from = BB_T(1) << turn.from, to = BB_T(1) << turn.to;
+        const bool color = (pieces[1] & to) != 0;
+        if (undo.promoted)
+            queens &= ~to;
+        pieces[color] ^= from | to;
+        if (queens & to)
+            queens ^= from | to;
+        if (turn.cap != -1)
+        {
+            const BB_T cap = BB_T(1) << turn.cap;
+            pieces[!color] |= cap;
+            if (undo.cap_queen)
+                queens |= cap;
+        }
+        key = undo.prev_key;
+        material = undo.prev_material;
+    }
+
+    bool operator==(const Position& other) const
+    {
+        return pieces[0] == other.pieces[0] && pieces[1] == other.pieces[1] && queens == other.queens;
+    }
+
+    bool operator!=(const Position& other) const
+    {
+        return !(*this == other);
+    }
+
+    // Учитывает в счётчиках фигуру type (в формате Board::mtx) на клетке sq со знаком sign
+    void count(const int sq, const POS_T type, const int sign)
+    {
+        const bool color = (type % 2 == 0);
+        if (type > 2)
+            material.kings[color] += int8_t(sign);
+        else
+        {
+            material.men[color] += int8_t(sign);
+            material.advance[color] += int16_t(sign * row_advance(color, sq));
+        }
+    }
+
+    // Преобразование из матрицы доски (используется только на границе с Board)
+    static Position from_mtx(const vector<vector<POS_T>>& mtx)
+    {
+        Position pos;
+        for (POS_T i = 0; i < 8; ++i)
+        {
+            for (POS_T j = 1 - i % 2; j < 8; j += 2)
+            {
+                if (mtx[i][j])
+                    pos.set_cell(sq_index(i, j), mtx[i][j]);
+            }
+        }
+        return pos;
+    }
+
+    // Позиция из восьми строк сверху вниз (для консольных программ): '.' - пустая клетка,
+    // w/b - белая/чёрная шашка, W/B - белая/чёрная дамка.
+    static Position from_text(const vector<string>& rows)
+    {
+        vector<vector<POS_T>> mtx(8, vector<POS_T>(8, 0));
+        const string pieces = ".wbWB";
+        for (int i = 0; i < 8; ++i)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                const size_t cell = (rows.size() == 8 && rows[i].size() == 8 ? pieces.find(rows[i][j]) : string::npos);
+                if (cell == string::npos || (cell && (i + j) % 2 == 0))
+                    throw invalid_argument("bad position row " + to_string(i));
+                mtx[i][j] = POS_T(cell);
+            }
+        }
+        return from_mtx(mtx);
+    }
+
+    // Обратное преобразование в матрицу доски
+    vector<vector<POS_T>> to_mtx() const
+    {
+        vector<vector<POS_T>> mtx(8, vector<POS_T>(8, 0));
+        for (int sq = 0; sq < 32; ++sq)
+        {
+            mtx[sq_x(sq)][sq_y(sq)] = cell(sq);
+        }
+        return mtx;
+    }
+};
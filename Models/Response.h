@@ -7,5 +7,6 @@ enum class Response
     BACK,    // Игрок запросил откат хода
     REPLAY,  // Игрок запросил перезапуск игры
     QUIT,    // Игрок вышел из игры
-    CELL     // Игрок выбрал ячейку на доске
+    CELL,    // Игрок выбрал ячейку на доске
+    WAKE     // Фоновая работа (поиск бота) сообщила о своём завершении
 };
@@ -0,0 +1,204 @@
+// Bench - консольный замер скорости поиска бота (без окна и SDL).
+// Для набора позиций и глубин выполняет поиск лучшего хода и выводит количество узлов, отсечений,
+// время, скорость (узлов в секунду) и найденный ход. Поиск детерминирован (seed 0, один поток),
+// поэтому количество узлов меняется только при изменении алгоритма.
+// Оценка выводится с точки зрения стороны, которая ходит, в единицах Score (см. Engine/Score.h).
+//
+// --check 1 дополнительно ищет каждую позицию без отсечений ("O0") и сверяет оценки: отсечения не должны
+// менять оценку корня. При сверке поиск с отсечениями берёт из таблицы транспозиций только записи той же
+// оставшейся глубины (оценка из записи большей глубины законно отличается от оценки на фиксированную глубину),
+// поэтому количество узлов в этом режиме отличается от обычного замера. Перебор без отсечений на глубине 9
+// идёт долго.
+//
+// Запуск: bench [--format text|csv|json] [--depths 3,6,9] [--hash MB] [--scoring NumberAndPotential] [--opt O1]
+//              [--quiescence 1] [--check 0]
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "Engine/Hash_table.h"
+#include "Engine/Searcher.h"
+
+// Позиция набора: восемь строк сверху вниз (см. Position::from_text) и цвет стороны, которая ходит.
+struct Bench_case
+{
+    string name;
+    vector<string> rows;
+    bool color;
+};
+
+const vector<Bench_case> bench_cases = {
+    { "start", { ".b.b.b.b", "b.b.b.b.", ".b.b.b.b", "........", "........", "w.w.w.w.", ".w.w.w.w", "w.w.w.w." }, 0 },
+    { "opening", { ".b.b.b.b", "b.b.b.b.", "...b.b.b", "..b.....", ".w......", "..w.w.w.", ".w.w.w.w", "w.w.w.w." }, 1 },
+    { "middle", { ".b.b...b", "b...b.b.", ".b...b..", "..b.w...", ".w.b....", "w...w.w.", ".w...w.w", "w.w....." }, 0 },
+    { "kings", { "........", "b.b.....", ".....b..", "..b.....", ".W...w..", "w...b...", ".....B.w", "W......." }, 0 },
+    { "ending", { "........", "......b.", "........", "..B.....", "........", "........", ".w.W....", "........" }, 1 },
+};
+
+// Результат одного поиска
+struct Bench_result
+{
+    string name;
+    int depth;
+    Score score;
+    uint64_t nodes, qnodes, cutoffs, hash_cutoffs;
+    double ms;
+    string best;
+    bool checked;   // Оценка сверена с поиском без отсечений
+    Score o0_score; // Оценка поиска без отсечений
+};
+
+// Клетка в шахматной записи: столбцы a-h слева направо, строки 1-8 снизу вверх
+string square_name(const POS_T x, const POS_T y)
+{
+    return string(1, char('a' + y)) + char('1' + (7 - x));
+}
+
+// Ход (цепочка ударов) в записи вида c3-d4 или c3:e5:c7
+string turns_name(const vector<move_pos>& turns)
+{
+    if (turns.empty() || turns[0].x == -1)
+        return "-";
+    string res = square_name(turns[0].x, turns[0].y);
+    for (const move_pos& turn : turns)
+        res += (turn.xb != -1 ? ":" : "-") + square_name(turn.x2, turn.y2);
+    return res;
+}
+
+// Поиск позиции test на глубину depth, searcher и таблица готовятся заново.
+Bench_result run_case(const Bench_case& test, const int depth, const string& scoring_mode, const string& optimization,
+                      const bool quiescence, const bool exact_draft, Hash_table& hash_table)
+{
+    // Каждый поиск начинается с чистой таблицы и новой истории ходов.
+    atomic<bool> stop(false);
+    Position pos = Position::from_text(test.rows);
+    Searcher searcher(scoring_mode, optimization, 0, quiescence);
+    searcher.exact_draft = exact_draft;
+    hash_table.clear();
+    hash_table.new_search();
+    searcher.new_search(&hash_table, &stop);
+    const auto start = chrono::steady_clock::now();
+    const Score score = searcher.search(pos, test.color, depth);
+    const double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    return { test.name, depth, score, searcher.nodes, searcher.qnodes, searcher.cutoffs, searcher.hash_cutoffs, ms,
+             turns_name(searcher.collect_best_turns()), false, 0 };
+}
+
+int main(int argc, char* argv[])
+{
+    string format = "text", scoring_mode = "NumberAndPotential", optimization = "O1";
+    vector<int> depths = { 3, 6, 9 };
+    size_t hash_mb = 16;
+    bool quiescence = true, check = false;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const string key = argv[i], value = argv[i + 1];
+        if (key == "--format")
+            format = value;
+        else if (key == "--hash")
+            hash_mb = size_t(atoi(value.c_str()));
+        else if (key == "--scoring")
+            scoring_mode = value;
+        else if (key == "--opt")
+            optimization = value;
+        else if (key == "--quiescence")
+            quiescence = (atoi(value.c_str()) != 0);
+        else if (key == "--check")
+            check = (atoi(value.c_str()) != 0);
+        else if (key == "--depths")
+        {
+            depths.clear();
+            stringstream list(value);
+            for (string depth; getline(list, depth, ',');)
+                depths.push_back(atoi(depth.c_str()));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", key.c_str());
+            return 1;
+        }
+    }
+
+    vector<Bench_result> results;
+    Hash_table hash_table(hash_mb);
+    // Поиск без отсечений таблицу транспозиций не использует.
+    Hash_table no_table(0);
+    int mismatches = 0;
+    for (const Bench_case& test : bench_cases)
+    {
+        for (const int depth : depths)
+        {
+            Bench_result r = run_case(test, depth, scoring_mode, optimization, quiescence, check, hash_table);
+            if (check)
+            {
+                r.checked = true;
+                r.o0_score = run_case(test, depth, scoring_mode, "O0", quiescence, false, no_table).score;
+                mismatches += (r.o0_score != r.score);
+            }
+            results.push_back(r);
+        }
+    }
+    // Результат сверки: ok или оценка поиска без отсечений
+    const auto check_name = [](const Bench_result& r) {
+        return (!r.checked ? string("-") : r.o0_score == r.score ? string("ok") : "O0=" + to_string(r.o0_score));
+    };
+
+    uint64_t total_nodes = 0;
+    double total_ms = 0;
+    for (const Bench_result& r : results)
+    {
+        total_nodes += r.nodes + r.qnodes;
+        total_ms += r.ms;
+    }
+    const auto nps = [](const uint64_t nodes, const double ms) { return ms > 0 ? nodes * 1000.0 / ms : 0.0; };
+
+    if (format == "csv")
+    {
+        printf("position,depth,score,nodes,qnodes,cutoffs,hash_cutoffs,time_ms,nps,best,check\n");
+        for (const Bench_result& r : results)
+            printf("%s,%d,%d,%llu,%llu,%llu,%llu,%.3f,%.0f,%s,%s\n", r.name.c_str(), r.depth, r.score,
+                   (unsigned long long)r.nodes, (unsigned long long)r.qnodes, (unsigned long long)r.cutoffs,
+                   (unsigned long long)r.hash_cutoffs, r.ms, nps(r.nodes + r.qnodes, r.ms), r.best.c_str(),
+                   check_name(r).c_str());
+    }
+    else if (format == "json")
+    {
+        printf("{\n  \"scoring\": \"%s\",\n  \"optimization\": \"%s\",\n  \"hash_mb\": %zu,\n  \"quiescence\": %s,\n"
+               "  \"results\": [\n",
+               scoring_mode.c_str(), optimization.c_str(), hash_mb, (quiescence ? "true" : "false"));
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Bench_result& r = results[i];
+            printf("    {\"position\": \"%s\", \"depth\": %d, \"score\": %d, \"nodes\": %llu, \"qnodes\": %llu, "
+                   "\"cutoffs\": %llu, \"hash_cutoffs\": %llu, \"time_ms\": %.3f, \"nps\": %.0f, \"best\": \"%s\", "
+                   "\"check\": \"%s\"}%s\n",
+                   r.name.c_str(), r.depth, r.score, (unsigned long long)r.nodes, (unsigned long long)r.qnodes,
+                   (unsigned long long)r.cutoffs, (unsigned long long)r.hash_cutoffs, r.ms, nps(r.nodes + r.qnodes, r.ms),
+                   r.best.c_str(), check_name(r).c_str(), (i + 1 < results.size() ? "," : ""));
+        }
+        printf("  ],\n  \"total_nodes\": %llu,\n  \"total_time_ms\": %.3f,\n  \"nps\": %.0f,\n  \"mismatches\": %d\n}\n",
+               (unsigned long long)total_nodes, total_ms, nps(total_nodes, total_ms), mismatches);
+    }
+    else
+    {
+        printf("%-8s %5s %10s %12s %10s %10s %10s %10s %12s  %-14s %s\n", "position", "depth", "score", "nodes",
+               "qnodes", "cutoffs", "hash_cut", "time_ms", "nps", "best", "check");
+        for (const Bench_result& r : results)
+            printf("%-8s %5d %10d %12llu %10llu %10llu %10llu %10.1f %12.0f  %-14s %s\n", r.name.c_str(), r.depth,
+                   r.score, (unsigned long long)r.nodes, (unsigned long long)r.qnodes, (unsigned long long)r.cutoffs,
+                   (unsigned long long)r.hash_cutoffs, r.ms, nps(r.nodes + r.qnodes, r.ms), r.best.c_str(),
+                   check_name(r).c_str());
+        printf("total: %llu nodes, %.1f ms, %.0f nps\n", (unsigned long long)total_nodes, total_ms,
+               nps(total_nodes, total_ms));
+        if (check)
+            printf("check: %d mismatches\n", mismatches);
+    }
+    // При расхождении с поиском без отсечений код возврата ненулевой (для скриптов).
+    return (mismatches ? 1 : 0);
+}
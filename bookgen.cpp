@@ -0,0 +1,114 @@
+// Bookgen - построение дебютной книги по партиям бота с самим собой (без окна и SDL).
+// Каждая партия играется с другим seed, поэтому равноценные ходы выбираются по-разному и партии расходятся.
+// Ходы первых plies полуходов всех партий записываются в книгу, вес хода - сколько раз его выбрал поиск.
+// Ходы, выбранные реже min-weight раз, в книгу не попадают.
+//
+// Запуск: bookgen [--games 64] [--plies 12] [--level 6] [--random-plies 0] [--min-weight 1] [--threads N]
+//                 [--scoring NumberAndPotential] [--out opening.book]
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "Engine/Logic.h"
+#include "Engine/Opening_book.h"
+
+int main(int argc, char* argv[])
+{
+    int games = 64, plies = 12, level = 6, random_plies = 0;
+    uint32_t min_weight = 1;
+    int threads = max(1, int(thread::hardware_concurrency()));
+    string scoring = "NumberAndPotential", out = "opening.book";
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const string key = argv[i], value = argv[i + 1];
+        if (key == "--games")
+            games = atoi(value.c_str());
+        else if (key == "--plies")
+            plies = atoi(value.c_str());
+        else if (key == "--level")
+            level = atoi(value.c_str());
+        else if (key == "--random-plies")
+            random_plies = atoi(value.c_str());
+        else if (key == "--min-weight")
+            min_weight = uint32_t(max(1, atoi(value.c_str())));
+        else if (key == "--threads")
+            threads = max(1, atoi(value.c_str()));
+        else if (key == "--scoring")
+            scoring = value;
+        else if (key == "--out")
+            out = value;
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", key.c_str());
+            return 1;
+        }
+    }
+
+    atomic<int> next_game(0);
+    mutex m;
+    vector<Book_entry> entries;
+    vector<thread> pool;
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&]() {
+            for (int game = next_game++; game < games; game = next_game++)
+            {
+                Engine_settings settings;
+                settings.seed = unsigned(game);
+                settings.scoring_mode = scoring;
+                settings.hash_mb = 8;
+                Logic logic(settings);
+                logic.Max_depth = level;
+                mt19937 rng(settings.seed);
+                Position pos = Position::from_text({ ".b.b.b.b", "b.b.b.b.", ".b.b.b.b", "........", "........",
+                                                     "w.w.w.w.", ".w.w.w.w", "w.w.w.w." });
+                vector<Book_entry> line;
+                for (int ply = 0; ply < plies; ++ply)
+                {
+                    const bool color = ply % 2;
+                    Move_list list;
+                    Move_gen::find_turns(pos, color, list);
+                    if (list.empty())
+                        break;
+                    if (ply < random_plies)
+                    {
+                        Move_gen::random_turn(pos, color, rng);
+                        continue;
+                    }
+                    Book_entry e;
+                    e.key = Opening_book::book_key(pos, color);
+                    Move_gen::apply_turns(pos, logic.find_best_turns(pos.to_mtx(), color));
+                    e.next_key = pos.key;
+                    e.weight = 1;
+                    line.push_back(e);
+                }
+                lock_guard<mutex> lock(m);
+                entries.insert(entries.end(), line.begin(), line.end());
+                printf("game %4d  %zu book moves\n", game + 1, line.size());
+                fflush(stdout);
+            }
+        });
+    }
+    for (thread& th : pool)
+        th.join();
+
+    // Объединяем одинаковые ходы и отбрасываем редкие
+    Opening_book::merge(entries);
+    entries.erase(remove_if(entries.begin(), entries.end(), [&](const Book_entry& e) { return e.weight < min_weight; }),
+                  entries.end());
+    if (!Opening_book::save(entries, out))
+    {
+        fprintf(stderr, "can't write %s\n", out.c_str());
+        return 1;
+    }
+    printf("written %s: %zu moves\n", out.c_str(), entries.size());
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Perft - консольная проверка и замер скорости генератора ходов (без окна и SDL).
+// Считает количество листьев дерева ходов до заданной глубины и сравнивает с таблицей известных значений.
+// Один ход - это полная цепочка ударов, поэтому разные цепочки считаются разными ходами.
+//
+// Запуск: perft [max_depth] - все позиции таблицы до глубины max_depth (по умолчанию до последней известной).
+// Код возврата 1, если хотя бы одно значение не совпало с таблицей.
+#include <stdint.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+using namespace std;
+
+#include "Engine/Move_gen.h"
+
+// Позиция задаётся восемью строками сверху вниз (см. Position::from_text). Белые ходят вверх.
+struct Perft_case
+{
+    string name;
+    vector<string> rows;
+    bool color;              // Чей ход: 0 - белые, 1 - чёрные
+    vector<uint64_t> counts; // Известные значения для глубин 1, 2, ...
+};
+
+// Количество листьев дерева на глубине depth (в полных ходах).
+// sq - клетка фигуры, продолжающей цепочку ударов (или -1).
+uint64_t perft(Position& pos, const bool color, const int depth, const int sq = -1)
+{
+    if (depth == 0 && sq == -1)
+        return 1;
+    Move_list list;
+    if (sq != -1)
+        Move_gen::find_turns(pos, sq, list);
+    else
+        Move_gen::find_turns(pos, color, list);
+
+    // Цепочка ударов закончилась: ход передаётся сопернику.
+    if (sq != -1 && !list.have_beats)
+        return perft(pos, !color, depth - 1);
+
+    uint64_t nodes = 0;
+    for (const sq_move turn : list)
+    {
+        Undo_info undo;
+        pos.make(turn, undo);
+        nodes += (list.have_beats ? perft(pos, color, depth, turn.to) : perft(pos, !color, depth - 1));
+        pos.unmake(turn, undo);
+    }
+    return nodes;
+}
+
+// Таблица позиций и известных значений (сверены с прежним генератором ходов на матрице доски).
+// Правила отличаются от русских шашек (побитая фигура снимается сразу), поэтому значения тоже отличаются.
+const vector<Perft_case> perft_cases = {
+    { "start",
+      { ".b.b.b.b", "b.b.b.b.", ".b.b.b.b", "........", "........", "w.w.w.w.", ".w.w.w.w", "w.w.w.w." },
+      0,
+      { 7, 49, 302, 1469, 7482, 37986, 190146, 929984, 4571392 } },
+    { "kings",
+      { "........", "b.b.....", ".....b..", "..b.....", ".W...w..", "w...b...", ".....B.w", "W......." },
+      0,
+      { 7, 25, 117, 902, 8078, 50187, 494592, 3018606 } },
+    { "chains",
+      { ".......B", "......b.", ".b.b....", "........", ".b.b....", "..w.....", "........", "........" },
+      0,
+      { 2, 4, 8, 34, 52, 402, 548, 4572, 8652 } },
+};
+
+int main(int argc, char* argv[])
+{
+    const int max_depth = (argc > 1 ? atoi(argv[1]) : 1 << 30);
+    bool ok = true;
+    for (const Perft_case& test : perft_cases)
+    {
+        Position pos = Position::from_text(test.rows);
+        for (int depth = 1; depth <= int(test.counts.size()) && depth <= max_depth; ++depth)
+        {
+            const auto start = chrono::steady_clock::now();
+            const uint64_t nodes = perft(pos, test.color, depth);
+            const double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            const bool match = (nodes == test.counts[depth - 1]);
+            ok = ok && match;
+            printf("%-8s depth %2d  nodes %12llu  time %8.3f s  nps %12.0f  %s\n", test.name.c_str(), depth,
+                   (unsigned long long)nodes, sec, (sec > 0 ? nodes / sec : 0.0), (match ? "ok" : "FAIL"));
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+// Tournament - консольный турнир двух настроек бота (без окна и SDL).
+// Играет заданное число партий параллельно на пуле потоков и выводит счёт с доверительным интервалом
+// и время ходов каждой стороны. Партии играются парами: одно и то же случайное начало с разменом цветов.
+//
+// Запуск: tournament [--games 100] [--threads N] [--random-plies 4] [--max-turns 120] [--seed 1]
+//                    [--a level=5,scoring=NumberAndPotential,opt=O1,hash=16,movetime=0,quiescence=1]
+//                    [--b level=5,scoring=NumberOnly,opt=O1,book=opening.book]
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#include "Engine/Logic.h"
+
+// Настройки одного участника
+struct Player_config
+{
+    int level = 5;
+    Engine_settings settings;
+
+    // Разбор строки вида level=5,scoring=NumberOnly,opt=O1,hash=16,movetime=0,quiescence=1,book=opening.book
+    static Player_config parse(const string& text)
+    {
+        Player_config res;
+        res.settings.hash_mb = 8;
+        stringstream list(text);
+        for (string item; getline(list, item, ',');)
+        {
+            const size_t eq = item.find('=');
+            const string key = item.substr(0, eq), value = (eq == string::npos ? "" : item.substr(eq + 1));
+            if (key == "level")
+                res.level = atoi(value.c_str());
+            else if (key == "scoring")
+                res.settings.scoring_mode = value;
+            else if (key == "opt")
+                res.settings.optimization = value;
+            else if (key == "hash")
+                res.settings.hash_mb = size_t(atoi(value.c_str()));
+            else if (key == "movetime")
+                res.settings.move_time_ms = atoi(value.c_str());
+            else if (key == "quiescence")
+                res.settings.quiescence = (atoi(value.c_str()) != 0);
+            else if (key == "book")
+                res.settings.book_path = value;
+            else
+                throw invalid_argument("unknown player option " + key);
+        }
+        return res;
+    }
+};
+
+// Время ходов одной стороны
+struct Move_times
+{
+    int moves = 0;
+    double total_ms = 0, max_ms = 0;
+
+    void add(const double ms)
+    {
+        ++moves;
+        total_ms += ms;
+        max_ms = max(max_ms, ms);
+    }
+
+    void add(const Move_times& other)
+    {
+        moves += other.moves;
+        total_ms += other.total_ms;
+        max_ms = max(max_ms, other.max_ms);
+    }
+};
+
+// Итог партии: 0 - ничья, 1 - победа белых, 2 - победа чёрных (как в Game::play)
+struct Game_result
+{
+    int res = 0;
+    int turns = 0;
+    Move_times times[2]; // Время ходов белых и чёрных
+};
+
+// Партия двух движков из начальной позиции: первые random_plies ходов делаются случайно.
+Game_result play_game(const Player_config& white, const Player_config& black, const int random_plies,
+                      const int max_turns, const unsigned seed)
+{
+    const Player_config* players[2] = { &white, &black };
+    Logic logics[2] = { Logic(white.settings), Logic(black.settings) };
+    for (int i = 0; i < 2; ++i)
+        logics[i].Max_depth = players[i]->level;
+
+    Position pos = Position::from_text(
+        { ".b.b.b.b", "b.b.b.b.", ".b.b.b.b", "........", "........", "w.w.w.w.", ".w.w.w.w", "w.w.w.w." });
+    mt19937 rng(seed);
+    Game_result result;
+    int turn_num = -1;
+    while (++turn_num < max_turns)
+    {
+        const bool color = turn_num % 2;
+        Move_list list;
+        Move_gen::find_turns(pos, color, list);
+        // Если ходов нет, игра завершается
+        if (list.empty())
+            break;
+        if (turn_num < random_plies)
+        {
+            Move_gen::random_turn(pos, color, rng);
+            continue;
+        }
+        const auto start = chrono::steady_clock::now();
+        const vector<move_pos> turns = logics[color].find_best_turns(pos.to_mtx(), color);
+        result.times[color].add(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        Move_gen::apply_turns(pos, turns);
+    }
+    result.turns = turn_num;
+    result.res = (turn_num == max_turns ? 0 : (turn_num % 2 ? 1 : 2));
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int games = 100, random_plies = 4, max_turns = 120;
+    unsigned seed = 1;
+    int threads = max(1, int(thread::hardware_concurrency()));
+    Player_config a = Player_config::parse("level=5"), b = Player_config::parse("level=5");
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const string key = argv[i], value = argv[i + 1];
+        if (key == "--games")
+            games = atoi(value.c_str());
+        else if (key == "--threads")
+            threads = max(1, atoi(value.c_str()));
+        else if (key == "--random-plies")
+            random_plies = atoi(value.c_str());
+        else if (key == "--max-turns")
+            max_turns = atoi(value.c_str());
+        else if (key == "--seed")
+            seed = unsigned(atoi(value.c_str()));
+        else if (key == "--a")
+            a = Player_config::parse(value);
+        else if (key == "--b")
+            b = Player_config::parse(value);
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", key.c_str());
+            return 1;
+        }
+    }
+
+    // Пул потоков: каждый поток берёт следующий номер партии, пока партии не закончатся.
+    // Партии 2k и 2k + 1 начинаются одинаково, но в нечётной участник A играет чёрными.
+    atomic<int> next_game(0);
+    mutex m;
+    int wins = 0, draws = 0, losses = 0;
+    Move_times times_a, times_b;
+    const auto start = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&]() {
+            for (int game = next_game++; game < games; game = next_game++)
+            {
+                const bool a_black = game % 2;
+                const Game_result r = (a_black ? play_game(b, a, random_plies, max_turns, seed + game / 2)
+                                               : play_game(a, b, random_plies, max_turns, seed + game / 2));
+                // Результат с точки зрения участника A
+                const int a_res = (r.res == 0 ? 0 : ((r.res == 1) != a_black ? 1 : -1));
+                lock_guard<mutex> lock(m);
+                wins += (a_res == 1);
+                draws += (a_res == 0);
+                losses += (a_res == -1);
+                times_a.add(r.times[a_black]);
+                times_b.add(r.times[!a_black]);
+                printf("game %4d  A plays %s  %s in %d turns\n", game + 1, (a_black ? "black" : "white"),
+                       (a_res == 1 ? "A wins" : (a_res == 0 ? "draw" : "B wins")), r.turns);
+                fflush(stdout);
+            }
+        });
+    }
+    for (thread& th : pool)
+        th.join();
+    const double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Доля набранных очков и её 95% доверительный интервал (нормальное приближение)
+    const int n = wins + draws + losses;
+    const double score = (n ? (wins + 0.5 * draws) / n : 0.5);
+    const double var = (n ? (wins * pow(1 - score, 2) + draws * pow(0.5 - score, 2) + losses * pow(score, 2)) / n : 0);
+    const double margin = 1.96 * sqrt(var / max(n, 1));
+    // Разница в рейтинге Эло, соответствующая доле очков
+    const auto elo = [](double s) {
+        s = min(max(s, 1e-3), 1 - 1e-3);
+        return -400 * log10(1 / s - 1);
+    };
+    printf("\n%d games in %.1f s on %d threads\n", n, sec, threads);
+    printf("A: W %d  D %d  L %d  score %.1f%% +- %.1f%%  elo %+.0f [%+.0f, %+.0f]\n", wins, draws, losses,
+           100 * score, 100 * margin, elo(score), elo(score - margin), elo(score + margin));
+    printf("A move time: mean %.1f ms, max %.1f ms (%d moves)\n", times_a.total_ms / max(times_a.moves, 1),
+           times_a.max_ms, times_a.moves);
+    printf("B move time: mean %.1f ms, max %.1f ms (%d moves)\n", times_b.total_ms / max(times_b.moves, 1),
+           times_b.max_ms, times_b.moves);
+    return 0;
+}